@@ -21,6 +21,8 @@
 __all__ = ["GLibEventLoop", "GLibEventLoopPolicy"]
 
 import contextlib
+import collections
+import heapq
 import sys
 import asyncio
 from asyncio import coroutines
@@ -31,7 +33,7 @@ import weakref
 import warnings
 from collections.abc import Mapping
 from contextlib import contextmanager
-from . import _ossighelper
+from . import _gi, _ossighelper
 
 from gi.repository import GLib
 
@@ -58,13 +60,13 @@ class _IdleSource(GLib.Source):
         if not self._loop._may_iterate:
             return False, -1
 
-        return bool(self._loop._idle_tasks), -1
+        return bool(self._loop._idle_priorities), -1
 
     def check(self):
         if not self._loop._may_iterate:
             return False
 
-        return bool(self._loop._idle_tasks)
+        return bool(self._loop._idle_priorities)
 
     def dispatch(self, callback, args):
         self._loop._glib_idle_dispatch()
@@ -105,6 +107,7 @@ class _GLibEventLoopMixin:
      * _source: the GSource subclass
      * _dispatching: boolean whether it is dispatching currently
      * attach/detach: add/remove the GSource from the main context
+     * pause/resume: stop/restart dispatching the attached GSource
 
     In principle, we simply override run_forever to call into GLib, with the
     assumption that a GSource is registered which will then call back into
@@ -140,7 +143,11 @@ class _GLibEventLoopMixin:
         self._context = main_context
         self._main_loop = GLib.MainLoop.new(self._context, False)
         self._quit_funcs = []
-        self._idle_tasks = []
+        # Handles of tasks with a non-default priority, in one FIFO per
+        # priority. The priorities with pending handles are kept in a heap.
+        self._idle_tasks = {}
+        self._idle_priorities = []
+        self._idle_source = None
         self._may_iterate = False
         self._loop_enter_count = 0
         self._loop_was_set = False
@@ -160,11 +167,11 @@ class _GLibEventLoopMixin:
 
         try:
             self._may_iterate = False
-            self._selector.detach()
+            self._selector.pause()
             yield
         finally:
             self._may_iterate = True
-            self._selector.attach()
+            self._selector.resume()
 
     @contextmanager
     def running(self, quit_func):
@@ -211,8 +218,8 @@ class _GLibEventLoopMixin:
             self._idle_source = _IdleSource(self)
             self._idle_source.attach(self._context)
             self._idle_source.set_name("GLibEventLoop._idle_source")
-            if self._idle_tasks:
-                self._idle_source.set_priority(self._idle_tasks[0][0])
+            if self._idle_priorities:
+                self._idle_source.set_priority(self._idle_priorities[0])
             with self:
                 yield
         finally:
@@ -276,11 +283,18 @@ class _GLibEventLoopMixin:
             return super()._call_soon(callback, args, context)
 
         handle = asyncio.Handle(callback, args, self, context)
-        self._idle_tasks.append((priority, handle))
-        self._idle_tasks.sort(key=lambda x: x[0])
+        try:
+            self._idle_tasks[priority].append(handle)
+        except KeyError:
+            self._idle_tasks[priority] = collections.deque((handle,))
+            heapq.heappush(self._idle_priorities, priority)
 
-        # Update priority
-        self._idle_source.set_priority(self._idle_tasks[0][0])
+            # Update priority
+            if (
+                self._idle_source is not None
+                and self._idle_priorities[0] == priority
+            ):
+                self._idle_source.set_priority(priority)
 
         return handle
 
@@ -296,21 +310,18 @@ class _GLibEventLoopMixin:
         assert self._may_iterate
 
         # Pause so that the main Source is not going to dispatch
-        # Note that this is pretty expensive, we could optimize it by detecting
-        # it when it happens and only doing the detach/attach dance if needed.
         with self.paused():
-            priority = self._idle_source.get_priority()
-
-            ready_handles = []
-            while self._idle_tasks and self._idle_tasks[0][0] == priority:
-                ready_handles.append(self._idle_tasks.pop(0)[1])
+            # The idle source always has the highest pending priority
+            priority = heapq.heappop(self._idle_priorities)
+            ready_handles = self._idle_tasks.pop(priority)
 
             for handle in ready_handles:
-                handle._run()
+                if not handle._cancelled:
+                    handle._run()
 
             # There are (new) tasks available to run, ensure the priority is correct
-            if self._idle_tasks:
-                self._idle_source.set_priority(self._idle_tasks[0][0])
+            if self._idle_priorities:
+                self._idle_source.set_priority(self._idle_priorities[0])
 
     def stop(self):
         # Simply quit the mainloop
@@ -393,7 +404,7 @@ class _GLibEventLoopRunMixin:
 
 
 class _SourceBase(GLib.Source):
-    """Common Source functionality for both unix and win32"""
+    """Source functionality implemented in Python, used on win32"""
 
     def __init__(self, selector):
         super().__init__()
@@ -582,38 +593,35 @@ if sys.platform != "win32":
             return fileobj
         return fileobj.fileno()
 
-    class _Source(_SourceBase):
-        def prepare(self):
-            timeout = self._loop()._get_timeout_ms()
+    class _Source(GLib.Source):
+        """The GSource of the selector, implemented in C.
 
-            # NOTE: Always return False, FDs are queried in check and the timeout
-            #       needs to be rechecked anyway.
-            return False, timeout
+        It owns the registered FDs and computes the timeout the same way as
+        _get_timeout_ms, so python is only entered to dispatch.
+        """
 
-        def check(self):
-            ready = []
-
-            for key in self._selector()._fd_to_key.values():
-                condition = self.query_unix_fd(key._tag)
-                events = 0
-                # ERR/HUP/NVAL trigger both read/write (PRI cannot happen)
-                if condition & ~GLib.IOCondition.OUT:
-                    events |= selectors.EVENT_READ
-                if condition & ~GLib.IOCondition.IN:
-                    events |= selectors.EVENT_WRITE
-                if events:
-                    ready.append((key, events))
-            self._ready = ready
+        @staticmethod
+        def __new__(cls, selector):
+            source = _gi.asyncio_source_new(selector._loop)
+            source.__class__ = cls
+            setattr(source, "__pygi_custom_source", True)
+            return source
 
-            timeout = self._loop()._get_timeout_ms()
-            if timeout == 0:
-                return True
+        def __init__(self, selector):
+            super().__init__()
+
+            # It is *not* safe to run the *python* part of the mainloop recursively.
+            # This error must be caught further up in the chain, otherwise the
+            # mainloop will be blocking without an obvious reason.
+            self.set_can_recurse(False)
+            self.set_name("python asyncio integration")
 
-            return bool(ready)
+        @property
+        def _dispatching(self):
+            return _gi.asyncio_source_is_dispatching(self)
 
-    class _SelectorKey(selectors.SelectorKey):
-        # Subclass to attach _tag
-        pass
+        def _get_ready(self):
+            return _gi.asyncio_source_get_ready(self)
 
     class _FileObjectMapping(Mapping):
         def __init__(self, fd_dict):
@@ -650,15 +658,13 @@ if sys.platform != "win32":
             self._source = _Source(self)
             # re-register the keys with the new source
             for key in self._fd_to_key.values():
-                self._register_key(key)
+                _gi.asyncio_source_register(self._source, key)
 
-        def _register_key(self, key):
-            condition = GLib.IOCondition(0)
-            if key.events & selectors.EVENT_READ:
-                condition |= GLib.IOCondition.IN
-            if key.events & selectors.EVENT_WRITE:
-                condition |= GLib.IOCondition.OUT
-            key._tag = self._source.add_unix_fd(key.fd, condition)
+        def pause(self):
+            _gi.asyncio_source_set_paused(self._source, True)
+
+        def resume(self):
+            _gi.asyncio_source_set_paused(self._source, False)
 
         def register(self, fileobj, events, data=None):
             if (not events) or (
@@ -670,9 +676,9 @@ if sys.platform != "win32":
             if fd in self._fd_to_key:
                 raise KeyError(f"{fileobj!r} (FD {fd}) is already registered")
 
-            key = _SelectorKey(fileobj, fd, events, data)
+            key = selectors.SelectorKey(fileobj, fd, events, data)
 
-            self._register_key(key)
+            _gi.asyncio_source_register(self._source, key)
 
             self._fd_to_key[fd] = key
             return key
@@ -686,7 +692,7 @@ if sys.platform != "win32":
             # object and calling a function on it will crash us.
             # Catch this by checking that the contained pointer is not NULL.
             if self._source and hash(self._source):
-                self._source.remove_unix_fd(key._tag)
+                _gi.asyncio_source_unregister(self._source, fd)
             del self._fd_to_key[fd]
 
             return key
@@ -795,6 +801,10 @@ else:
         def detach(self):
             self._source.disable()
 
+        # Disabling the source is cheap already
+        pause = detach
+        resume = attach
+
 
 # The following are deprecated in 3.13 and will be removed in 3.16,
 # keep current code working that uses it to the point that we can.
@@ -32,6 +32,7 @@
 #include "pygi-capi.h"
 #include "pygi-ccallback.h"
 #include "pygi-closure.h"
+#include "pygi-dbus.h"
 #include "pygi-error.h"
 #include "pygi-foreign.h"
 #include "pygi-fundamental.h"
@@ -40,10 +41,12 @@
 #include "pygi-repository.h"
 #include "pygi-resulttuple.h"
 #include "pygi-source.h"
+#include "pygi-stream.h"
 #include "pygi-struct.h"
 #include "pygi-type.h"
 #include "pygi-util.h"
 #include "pygi-value.h"
+#include "pygi-variant.h"
 #include "pyginterface.h"
 #include "pygobject-object.h"
 #include "pygobject-props.h"
@@ -678,6 +681,52 @@ failure:
     return NULL;
 }
 
+static PyObject *
+pyg_channel_readinto (PyObject *self, PyObject *args)
+{
+    PyObject *py_iochannel, *py_buffer;
+    Py_buffer view;
+    gsize total_read = 0;
+    GIOStatus status = G_IO_STATUS_NORMAL;
+    GIOChannel *iochannel;
+    /* Cleared by pygi_error_check(). */
+    GError *error = NULL;
+
+    if (!PyArg_ParseTuple (args, "OO:pyg_channel_readinto", &py_iochannel,
+                           &py_buffer)) {
+        return NULL;
+    }
+    if (!pyg_boxed_check (py_iochannel, G_TYPE_IO_CHANNEL)) {
+        PyErr_SetString (PyExc_TypeError,
+                         "first argument is not a GLib.IOChannel");
+        return NULL;
+    }
+
+    if (PyObject_GetBuffer (py_buffer, &view, PyBUF_WRITABLE) == -1)
+        return NULL;
+
+    iochannel = pyg_boxed_get (py_iochannel, GIOChannel);
+
+    /* The buffer export keeps the memory alive and prevents resizing while
+     * the GIL is released */
+    Py_BEGIN_ALLOW_THREADS;
+    while (status == G_IO_STATUS_NORMAL && total_read < (gsize)view.len) {
+        gsize single_read = 0;
+
+        status = g_io_channel_read_chars (
+            iochannel, (char *)view.buf + total_read,
+            (gsize)view.len - total_read, &single_read, &error);
+        total_read += single_read;
+    }
+    Py_END_ALLOW_THREADS;
+
+    PyBuffer_Release (&view);
+
+    if (pygi_error_check (&error)) return NULL;
+
+    return PyLong_FromSize_t (total_read);
+}
+
 static PyObject *
 pyg_main_context_query (PyObject *self, PyObject *args, PyObject *kwargs)
 {
@@ -1034,7 +1083,33 @@ static PyMethodDef _gi_functions[] = {
     { "pyos_setsig", (PyCFunction)_wrap_pyig_pyos_setsig, METH_VARARGS },
     { "source_set_callback", (PyCFunction)pygi_source_set_callback,
       METH_VARARGS },
+    { "batch_source_new", (PyCFunction)pygi_batch_source_new, METH_VARARGS },
+    { "batch_source_push", (PyCFunction)pygi_batch_source_push,
+      METH_VARARGS },
+#ifdef G_OS_UNIX
+    { "asyncio_source_new", (PyCFunction)pygi_asyncio_source_new, METH_O },
+    { "asyncio_source_register", (PyCFunction)pygi_asyncio_source_register,
+      METH_VARARGS },
+    { "asyncio_source_unregister",
+      (PyCFunction)pygi_asyncio_source_unregister, METH_VARARGS },
+    { "asyncio_source_get_ready", (PyCFunction)pygi_asyncio_source_get_ready,
+      METH_O },
+    { "asyncio_source_set_paused",
+      (PyCFunction)pygi_asyncio_source_set_paused, METH_VARARGS },
+    { "asyncio_source_is_dispatching",
+      (PyCFunction)pygi_asyncio_source_is_dispatching, METH_O },
+#endif
     { "io_channel_read", (PyCFunction)pyg_channel_read, METH_VARARGS },
+    { "io_channel_readinto", (PyCFunction)pyg_channel_readinto, METH_VARARGS },
+    { "input_stream_readinto", (PyCFunction)pygi_input_stream_readinto,
+      METH_VARARGS },
+    { "stream_pump_new", (PyCFunction)pygi_stream_pump_new, METH_VARARGS },
+    { "stream_pump_ack", (PyCFunction)pygi_stream_pump_ack, METH_VARARGS },
+    { "stream_pump_stop", (PyCFunction)pygi_stream_pump_stop, METH_O },
+    { "variant_new", (PyCFunction)pygi_variant_new, METH_VARARGS },
+    { "variant_unpack", (PyCFunction)pygi_variant_unpack, METH_O },
+    { "dbus_connection_export", (PyCFunction)pygi_dbus_connection_export,
+      METH_VARARGS },
     { "main_context_query", (PyCFunction)pyg_main_context_query,
       METH_VARARGS },
     { "require_foreign", (PyCFunction)pygi_require_foreign,
@@ -30,10 +30,14 @@ from ..module import (
     get_platform_specific_module,
 )
 from .._gi import (
+    BytesBoxed,
     variant_type_from_string,
     source_new,
     source_set_callback,
+    batch_source_new,
+    batch_source_push,
     io_channel_read,
+    io_channel_readinto,
     main_context_query,
     PyGIWarning,
 )
@@ -494,6 +498,17 @@ class Variant(GLib.Variant):
 __all__.append("Variant")
 
 
+class Bytes(GLib.Bytes, BytesBoxed):
+    """:obj:`~gi.repository.GLib.Bytes` supports the buffer protocol, so
+    its data can be used with :class:`memoryview`, :mod:`hashlib` and others
+    without copying it through ``get_data()``.
+    """
+
+
+Bytes = override(Bytes)
+__all__.append("Bytes")
+
+
 def markup_escape_text(text: str | bytes, length: int = -1) -> str:
     if isinstance(text, bytes):
         return GLib.markup_escape_text(text.decode("UTF-8"), length)
@@ -750,6 +765,51 @@ class Timeout(Source):
 __all__.append("Timeout")
 
 
+class IdleBatch(Source):
+    """An idle source which runs queued callables in batches.
+
+    :param priority: the priority of the source
+    :param budget: if not 0, the time in milliseconds after which a dispatch
+        stops and leaves the remaining callables to the next main loop
+        iteration
+
+    Callables queued with :meth:`add` run in the order they were added, all
+    of them in a single dispatch of the source. Unlike :func:`idle_add` this
+    doesn't create a source per call, and :meth:`add` can be called from any
+    thread. The return values of the callables are ignored.
+
+    .. code-block:: python
+
+        batch = GLib.IdleBatch()
+        batch.attach(None)
+        batch.add(label.set_text, "done")
+    """
+
+    @staticmethod
+    def __new__(
+        cls: type[Self],
+        priority: int = GLib.PRIORITY_DEFAULT_IDLE,
+        budget: float = 0,
+    ) -> Self:
+        source = batch_source_new(int(budget * 1000))
+        source.__class__ = cls
+        return source  # type: ignore[return-value]
+
+    def __init__(
+        self, priority: int = GLib.PRIORITY_DEFAULT_IDLE, budget: float = 0
+    ) -> None:
+        if priority != GLib.PRIORITY_DEFAULT:
+            self.set_priority(priority)
+        self.set_name("GLib.IdleBatch")
+
+    def add(self, function: typing.Callable[..., typing.Any], *user_data) -> None:
+        """Queues ``function(*user_data)`` to run in the next dispatch."""
+        batch_source_push(self, function, user_data)
+
+
+__all__.append("IdleBatch")
+
+
 # backwards compatible API
 def idle_add(
     function: typing.Callable[..., bool | None],
@@ -899,6 +959,15 @@ class IOChannel(GLib.IOChannel):
         """Alias for GLib.IOChannel.read()."""
         return self.read(max_count)
 
+    def readinto(self, buffer: typing.Any) -> int:
+        """Reads data from a :obj:`~gi.repository.GLib.IOChannel` into a
+        writable buffer, like a :class:`bytearray` or :class:`memoryview`.
+
+        Reads until the buffer is full or the end of the channel is reached
+        and returns the number of bytes read.
+        """
+        return io_channel_readinto(self, buffer)
+
     def readline(self, size_hint: int = -1) -> str:
         # note, size_hint is just to maintain backwards compatible API; the
         # old static binding did not actually use it
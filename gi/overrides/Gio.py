@@ -16,9 +16,19 @@
 # USA
 
 import asyncio
+import collections
 import os
 import warnings
 
+from .._gi import (
+    input_stream_readinto,
+    stream_pump_new,
+    stream_pump_ack,
+    stream_pump_stop,
+    variant_new,
+    variant_unpack,
+    dbus_connection_export,
+)
 from .._ossighelper import register_sigint_fallback, get_event_loop
 from ..overrides import (
     override,
@@ -38,7 +48,7 @@ from gi import PyGIWarning
 from gi.repository import GLib
 from gi.repository import GObject
 
-from typing import Generic, TypeVar, overload
+from typing import Any, Generic, TypeVar, overload
 from collections.abc import Callable, Generator, Sequence
 
 import sys
@@ -370,10 +380,64 @@ class DBusConnection(Gio.DBusConnection):
                 set_property_closure,
             )
 
+    def export_object(self, object_path, interface_info, obj):
+        """Export the methods of obj described by interface_info.
+
+        Incoming calls of a method are dispatched to the attribute of obj with
+        the same name, with the unpacked parameters as positional arguments.
+        Methods with a single out-arg return it directly, methods without
+        out-args return None and others return a tuple. Raising GLib.Error
+        returns it to the caller, other exceptions are returned as
+        org.freedesktop.DBus.Python.<type> errors. Methods missing on obj
+        return org.freedesktop.DBus.Error.UnknownMethod. Properties are not
+        exported.
+
+        Returns the registration id to pass to unregister_object().
+        """
+        methods = {}
+        for method_info in interface_info.methods:
+            func = getattr(obj, method_info.name, None)
+            if func is None:
+                continue
+            out_signature = (
+                "(" + "".join(a.signature for a in method_info.out_args) + ")"
+            )
+            methods[method_info.name] = (func, out_signature)
+
+        return dbus_connection_export(self, object_path, interface_info, methods)
+
 
 __all__.append("DBusConnection")
 
 
+# (interface name, method name) -> in-signature, filled from the
+# DBusInterfaceInfo of proxies which have one
+# Keyed on the interface info itself, different proxies can describe the same
+# interface name differently. The key keeps the info alive, so it can't be
+# mistaken for a later one at the same address.
+_dbus_in_signatures = {}
+
+
+def _dbus_in_signature(dbus_proxy, method_name):
+    interface_info = dbus_proxy.get_interface_info()
+    if interface_info is None:
+        return None
+
+    key = (interface_info, method_name)
+    try:
+        return _dbus_in_signatures[key]
+    except KeyError:
+        pass
+
+    method_info = interface_info.lookup_method(method_name)
+    if method_info is None:
+        return None
+
+    signature = "(" + "".join(a.signature for a in method_info.in_args) + ")"
+    _dbus_in_signatures[key] = signature
+    return signature
+
+
 class _DBusProxyMethodCall:
     """Helper class to implement DBusProxy method calls."""
 
@@ -396,18 +460,17 @@ class _DBusProxyMethodCall:
 
         result_callback(obj, self._unpack_result(ret), real_user_data)
 
-    def __call__(
-        self,
-        *args,
-        result_handler=None,
-        error_handler=None,
-        user_data=None,
-        flags=0,
-        timeout=-1,
-    ):
-        # the first positional argument is the signature, unless we are calling
-        # a method without arguments; then signature is implied to be '()'.
-        if args:
+    def _build_args(self, args):
+        # the first positional argument is the signature. It can be omitted
+        # for methods without arguments, where it is implied to be '()', and
+        # for methods described by the proxy's interface info. A first
+        # argument equal to the signature from the interface info is still
+        # taken as the signature.
+        signature = _dbus_in_signature(self.dbus_proxy, self.method_name)
+        if signature is not None:
+            if args and isinstance(args[0], str) and args[0] == signature:
+                args = args[1:]
+        elif args:
             signature = args[0]
             args = args[1:]
             if not isinstance(signature, str):
@@ -417,7 +480,18 @@ class _DBusProxyMethodCall:
         else:
             signature = "()"
 
-        arg_variant = GLib.Variant(signature, tuple(args))
+        return variant_new(signature, tuple(args))
+
+    def __call__(
+        self,
+        *args,
+        result_handler=None,
+        error_handler=None,
+        user_data=None,
+        flags=0,
+        timeout=-1,
+    ):
+        arg_variant = self._build_args(args)
 
         if result_handler is not None:
             # asynchronous call
@@ -439,10 +513,18 @@ class _DBusProxyMethodCall:
             return self._unpack_result(result)
         return None
 
+    async def call_async(self, *args, flags=0, timeout=-1):
+        """Call the method and return an awaitable for its unpacked result."""
+        arg_variant = self._build_args(args)
+        result = await self.dbus_proxy.call(
+            self.method_name, arg_variant, flags, timeout, None
+        )
+        return self._unpack_result(result)
+
     @classmethod
     def _unpack_result(klass, result):
         """Convert a D-BUS return variant into an appropriate return value."""
-        result = result.unpack()
+        result = variant_unpack(result)
 
         # to be compatible with standard Python behaviour, unbox
         # single-element tuples and return None for empty result tuples
@@ -469,7 +551,10 @@ class DBusProxy(Gio.DBusProxy):
 
     The exception are methods which take no arguments, like
     proxy.MyMethod('()'). For these you can omit the signature and just write
-    proxy.MyMethod().
+    proxy.MyMethod(). The signature can also be omitted if the proxy has
+    interface info (see Gio.DBusProxy.set_interface_info()) describing the
+    method. A first argument equal to the signature from the interface info
+    is then still taken as the signature, anything else as a method argument.
 
     Optional keyword arguments:
 
@@ -498,6 +583,10 @@ class DBusProxy(Gio.DBusProxy):
 
       proxy.MyMethod('(is)', 42, 'hello',
           result_handler=mymethod_done, user_data='data')
+
+    Inside a coroutine the result can also be awaited:
+
+      result = await proxy.MyMethod.call_async('(is)', 42, 'hello')
     """
 
     def __getattr__(self, name):
@@ -567,6 +656,22 @@ class ListStore(Gio.ListStore, Generic[ObjectItemType]):
         compare_func = wrap_list_store_sort_func(compare_func)
         return super().insert_sorted(item, compare_func, *user_data)
 
+    def sort_by_key(
+        self, key: Callable[[ObjectItemType], Any], reverse: bool = False
+    ) -> None:
+        """Sort the items of the store by the values returned by `key`.
+
+        Unlike :meth:`sort`, `key` is called only once per item. The items
+        are then sorted like :func:`sorted` does and replaced with a single
+        :meth:`Gio.ListStore.splice`, so the ``items-changed`` signal is
+        emitted once.
+        """
+        n_items = self.get_n_items()
+        items = sorted(
+            [self.get_item(i) for i in range(n_items)], key=key, reverse=reverse
+        )
+        self.splice(0, n_items, items)
+
     def __delitem__(self, key: int | slice) -> None:
         if isinstance(key, slice):
             start, stop, step = key.indices(len(self))
@@ -642,6 +747,95 @@ ListStore = override(ListStore)
 __all__.append("ListStore")
 
 
+class InputStream(Gio.InputStream):
+    def readinto(self, buffer, cancellable=None):
+        """Reads data from the stream into a writable buffer, like a
+        :class:`bytearray` or :class:`memoryview`, without copying.
+
+        Like :meth:`Gio.InputStream.read`, this may read fewer bytes than
+        fit into the buffer. Returns the number of bytes read, 0 at the end
+        of the stream.
+        """
+        return input_stream_readinto(self, buffer, cancellable)
+
+    async def iter_chunks(self, chunk_size=65536, read_ahead=4, cancellable=None):
+        """Asynchronously iterates over the data of the stream, as
+        :class:`memoryview` objects of at most ``chunk_size`` bytes.
+
+        The stream is read in a worker thread without holding the GIL, up to
+        ``read_ahead`` chunks ahead of the consumer. All chunks read in the
+        meantime are handed over at once, so Python is entered once per batch
+        of chunks instead of once per read. Leaving the loop early cancels
+        the read in progress.
+
+        This needs an asyncio event loop running the thread default
+        :obj:`GLib.MainContext`, see :mod:`gi.events`.
+        """
+        loop = asyncio.get_running_loop()
+        batches = collections.deque()
+        waiter = None
+
+        def callback(chunks, error, total):
+            batches.append((chunks, error))
+            if waiter is not None and not waiter.done():
+                waiter.set_result(None)
+
+        pump = stream_pump_new(
+            self, None, chunk_size, read_ahead, cancellable, callback
+        )
+        try:
+            while True:
+                if not batches:
+                    waiter = loop.create_future()
+                    await waiter
+                    waiter = None
+                chunks, error = batches.popleft()
+                if chunks is None:
+                    if error is not None:
+                        raise error
+                    return
+                for chunk in chunks:
+                    yield memoryview(chunk)
+                stream_pump_ack(pump, len(chunks))
+        finally:
+            stream_pump_stop(pump)
+
+
+InputStream = override(InputStream)
+__all__.append("InputStream")
+
+
+class OutputStream(Gio.OutputStream):
+    async def pump_from(self, source, chunk_size=65536, cancellable=None):
+        """Copies all data of the :obj:`Gio.InputStream` ``source`` into
+        this stream and returns the number of bytes copied.
+
+        Unlike :meth:`Gio.OutputStream.splice_async`, the chunk size can be
+        chosen and the copy runs in a worker thread without entering Python
+        until it is done. This needs an asyncio event loop running the thread
+        default :obj:`GLib.MainContext`, see :mod:`gi.events`.
+        """
+        future = asyncio.get_running_loop().create_future()
+
+        def callback(chunks, error, total):
+            if future.done():
+                return
+            if error is not None:
+                future.set_exception(error)
+            else:
+                future.set_result(total)
+
+        pump = stream_pump_new(source, self, chunk_size, 1, cancellable, callback)
+        try:
+            return await future
+        finally:
+            stream_pump_stop(pump)
+
+
+OutputStream = override(OutputStream)
+__all__.append("OutputStream")
+
+
 class DataInputStream(Gio.DataInputStream):
     def __iter__(self):
         return self
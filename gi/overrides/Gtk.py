@@ -965,13 +965,21 @@ class TreeModel(Gtk.TreeModel):
             return prev_iter
         return None
 
-    def _convert_row(self, row):
+    def _get_column_types(self):
+        return [self.get_column_type(i) for i in range(self.get_n_columns())]
+
+    def _convert_row(self, row, column_types=None):
         # TODO: Accept a dictionary for row
         # model.append(None,{COLUMN_ICON: icon, COLUMN_NAME: name})
         if isinstance(row, str):
             raise TypeError("Expected a list or tuple, but got str")
 
-        n_columns = self.get_n_columns()
+        # Passed in when converting many rows, see ListStore.extend(). For a
+        # single row the type is only looked up for values that need it.
+        if column_types is None:
+            n_columns = self.get_n_columns()
+        else:
+            n_columns = len(column_types)
         if len(row) != n_columns:
             raise ValueError("row sequence has the incorrect number of elements")
 
@@ -981,7 +989,8 @@ class TreeModel(Gtk.TreeModel):
             # do not try to set None values, they are causing warnings
             if value is None:
                 continue
-            result.append(self._convert_value(cur_col, value))
+            column_type = column_types[cur_col] if column_types else None
+            result.append(self._convert_value(cur_col, value, column_type=column_type))
             columns.append(cur_col)
         return (result, columns)
 
@@ -990,11 +999,13 @@ class TreeModel(Gtk.TreeModel):
         for column in columns:
             self.set_value(treeiter, column, row[column])
 
-    def _convert_value(self, column, value):
+    def _convert_value(self, column, value, column_type=None):
         """Convert value to a GObject.Value of the expected type."""
         if isinstance(value, GObject.Value):
             return value
-        return GObject.Value(self.get_column_type(column), value)
+        if column_type is None:
+            column_type = self.get_column_type(column)
+        return GObject.Value(column_type, value)
 
     def get(self, treeiter, *columns):
         n_columns = self.get_n_columns()
@@ -1105,6 +1116,19 @@ class ListStore(Gtk.ListStore, TreeModel, TreeSortable):
     def insert(self, position, row=None):
         return self._do_insert(position, row)
 
+    def extend(self, rows):
+        """Append all rows of the iterable `rows` to the end of the store.
+
+        The column types are looked up once for all rows instead of once per
+        value, which makes this faster than calling :meth:`append` in a loop
+        when loading large tables.
+        """
+        column_types = self._get_column_types()
+
+        for row in rows:
+            values, columns = self._convert_row(row, column_types)
+            self.insert_with_values(-1, columns, values)
+
     def insert_before(self, sibling, row=None):
         if row is not None:
             if sibling is None:
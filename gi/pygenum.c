@@ -28,6 +28,39 @@ GQuark pygenum_class_key;
 
 PyTypeObject *PyGEnum_Type;
 static PyObject *IntEnum_Type;
+static PyObject *str_value2member_map;
+
+/**
+ * pyg_enum_lookup_member:
+ * @pyclass: an enum.Enum subclass
+ * @value: the integer value
+ *
+ * Looks @value up in the value to member map maintained by the enum module,
+ * which also holds the composite flags created by earlier conversions. This
+ * skips the EnumType.__call__() round trip for values which are already
+ * known.
+ *
+ * Returns: a new reference to the member, or %NULL without an exception set
+ * if the value isn't known yet.
+ */
+PyObject *
+pyg_enum_lookup_member (PyObject *pyclass, PyObject *value)
+{
+    PyObject *map, *member;
+
+    map = PyObject_GetAttr (pyclass, str_value2member_map);
+    if (!map) {
+        PyErr_Clear ();
+        return NULL;
+    }
+
+    member = PyDict_Check (map) ? PyDict_GetItemWithError (map, value) : NULL;
+    Py_XINCREF (member);
+    Py_DECREF (map);
+    if (!member) PyErr_Clear ();
+
+    return member;
+}
 
 PyObject *
 pyg_enum_val_new (PyObject *pyclass, int value)
@@ -38,6 +71,12 @@ pyg_enum_val_new (PyObject *pyclass, int value)
     intvalue = PyLong_FromLong (value);
     if (!intvalue) return NULL;
 
+    retval = pyg_enum_lookup_member (pyclass, intvalue);
+    if (retval) {
+        Py_DECREF (intvalue);
+        return retval;
+    }
+
     args[1] = intvalue;
     retval = PyObject_Vectorcall (pyclass, &args[1],
                                   1 + PY_VECTORCALL_ARGUMENTS_OFFSET, NULL);
@@ -446,6 +485,8 @@ pygi_enum_register_types (PyObject *mod)
     int i;
 
     pygenum_class_key = g_quark_from_static_string ("PyGEnum::class");
+    str_value2member_map = PyUnicode_InternFromString ("_value2member_map_");
+    if (!str_value2member_map) return -1;
 
     enum_module = PyImport_ImportModule ("enum");
     if (!enum_module) return -1;
@@ -19,6 +19,7 @@
  * License along with this library; if not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "pygenum.h"
 #include "pygflags.h"
 
 #include "pygi-type.h"
@@ -38,6 +39,12 @@ pyg_flags_val_new (PyObject *pyclass, guint value)
     intvalue = PyLong_FromUnsignedLong (value);
     if (!intvalue) return NULL;
 
+    retval = pyg_enum_lookup_member (pyclass, intvalue);
+    if (retval) {
+        Py_DECREF (intvalue);
+        return retval;
+    }
+
     args[1] = intvalue;
     retval = PyObject_Vectorcall (pyclass, &args[1],
                                   1 + PY_VECTORCALL_ARGUMENTS_OFFSET, NULL);
@@ -21,6 +21,7 @@
 
 #include "pygboxed.h"
 #include "pygi-invoke.h"
+#include "pygi-trace.h"
 #include "pygi-util.h"
 #include "pygobject-object.h"
 
@@ -30,6 +31,17 @@ static PyObject *asyncio_get_running_loop;
 static PyObject *contextvars_copy_context;
 #endif
 static PyObject *cancellable_info;
+static PyObject *str_call_soon;
+static PyObject *str__context;
+static PyObject *kwnames_context;
+
+/* Gio async I/O creates one awaitable per call, keep some of them around
+ * for reuse. */
+#if !defined(PYPY_VERSION) && !defined(Py_GIL_DISABLED)
+#define ASYNC_FREELIST_SIZE 64
+static PyGIAsync *async_freelist[ASYNC_FREELIST_SIZE];
+static int async_freelist_len;
+#endif
 
 /* This is never instantiated. */
 PYGI_DEFINE_TYPE ("gi._gi.Async", PyGIAsync_Type, PyGIAsync)
@@ -123,26 +135,15 @@ async_exception (PyGIAsync *self)
     return res;
 }
 
+/* loop.call_soon(cb->func, self, context=cb->context) */
 static PyObject *
 call_soon (PyGIAsync *self, PyGIAsyncCallback *cb)
 {
-    PyObject *call_soon;
-    PyObject *args, *kwargs = NULL;
-    PyObject *ret;
-
-    call_soon = PyObject_GetAttrString (self->loop, "call_soon");
-    if (!call_soon) return NULL;
-
-    args = Py_BuildValue ("(OO)", cb->func, self);
-    kwargs = PyDict_New ();
-    PyDict_SetItemString (kwargs, "context", cb->context);
-    ret = PyObject_Call (call_soon, args, kwargs);
+    PyObject *args[] = { self->loop, cb->func, (PyObject *)self,
+                         cb->context };
 
-    Py_CLEAR (args);
-    Py_CLEAR (kwargs);
-    Py_CLEAR (call_soon);
-
-    return ret;
+    return PyObject_VectorcallMethod (str_call_soon, args, 3,
+                                      kwnames_context);
 }
 
 static PyObject *
@@ -215,20 +216,14 @@ async_remove_done_callback (PyGIAsync *self, PyObject *fn)
 }
 
 static int
-async_init (PyGIAsync *self, PyObject *args, PyObject *kwargs)
+async_setup (PyGIAsync *self, PyObject *finish_func, PyObject *cancellable)
 {
-    static char *kwlist[] = { "finish_func", "cancellable", NULL };
     PyObject *context = NULL;
     GMainContext *ctx = NULL;
     int ret = -1;
 
-    if (!PyArg_ParseTupleAndKeywords (
-            args, kwargs, "O!|O!$:gi._gi.Async.__init__", kwlist,
-            &PyGICallableInfo_Type, &self->finish_func, &PyGObject_Type,
-            &self->cancellable))
-        goto out;
-
-    Py_INCREF (self->finish_func);
+    self->finish_func = (PyGICallableInfo *)Py_NewRef (finish_func);
+    self->cancellable = Py_XNewRef (cancellable);
 
     /* We need to pull in Gio.Cancellable at some point, but we delay it
      * until really needed to avoid having a dependency.
@@ -248,8 +243,6 @@ async_init (PyGIAsync *self, PyObject *args, PyObject *kwargs)
     if (self->cancellable) {
         int res;
 
-        Py_INCREF (self->cancellable);
-
         res = PyObject_IsInstance (self->cancellable, cancellable_info);
         if (res == -1) goto out;
 
@@ -260,10 +253,11 @@ async_init (PyGIAsync *self, PyObject *args, PyObject *kwargs)
             goto out;
         }
     } else {
-        self->cancellable = PyObject_CallObject (cancellable_info, NULL);
+        self->cancellable = PyObject_CallNoArgs (cancellable_info);
+        if (!self->cancellable) goto out;
     }
 
-    self->loop = PyObject_CallObject (asyncio_get_running_loop, NULL);
+    self->loop = PyObject_CallNoArgs (asyncio_get_running_loop);
     if (!self->loop) goto out;
 
     /* We use g_main_context_ref_thread_default() here, as that is what GTask
@@ -279,7 +273,7 @@ async_init (PyGIAsync *self, PyObject *args, PyObject *kwargs)
     assert (ctx != NULL);
 
     /* Duck-type the running loop. It needs to have a _context attribute. */
-    context = PyObject_GetAttrString (self->loop, "_context");
+    context = PyObject_GetAttr (self->loop, str__context);
     if (context == NULL) goto out;
 
     if (!pyg_boxed_check (context, G_TYPE_MAIN_CONTEXT)
@@ -294,12 +288,27 @@ async_init (PyGIAsync *self, PyObject *args, PyObject *kwargs)
     ret = 0;
 
 out:
-    g_main_context_unref (ctx);
+    if (ctx != NULL) g_main_context_unref (ctx);
     Py_XDECREF (context);
 
     return ret;
 }
 
+static int
+async_init (PyGIAsync *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = { "finish_func", "cancellable", NULL };
+    PyObject *finish_func, *cancellable = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords (
+            args, kwargs, "O!|O!$:gi._gi.Async.__init__", kwlist,
+            &PyGICallableInfo_Type, &finish_func, &PyGObject_Type,
+            &cancellable))
+        return -1;
+
+    return async_setup (self, finish_func, cancellable);
+}
+
 static PyMethodDef async_methods[] = {
     { "cancel", (PyCFunction)async_cancel, METH_VARARGS | METH_KEYWORDS },
     { "done", (PyCFunction)async_done, METH_NOARGS },
@@ -363,7 +372,7 @@ static void
 async_finalize (PyGIAsync *self)
 {
     if (self->log_tb) {
-        PyObject *error_type, *error_value, *error_traceback;
+        PyObject *saved_exc;
         PyObject *context = NULL;
         PyObject *message = NULL;
         PyObject *call_exception_handler = NULL;
@@ -373,7 +382,7 @@ async_finalize (PyGIAsync *self)
         self->log_tb = 0;
 
         /* Save the current exception, if any. */
-        PyErr_Fetch (&error_type, &error_value, &error_traceback);
+        saved_exc = PyErr_GetRaisedException ();
 
         context = PyDict_New ();
         if (!context) goto finally;
@@ -401,7 +410,7 @@ finally:
         Py_CLEAR (call_exception_handler);
 
         /* Restore the saved exception. */
-        PyErr_Restore (error_type, error_value, error_traceback);
+        PyErr_SetRaisedException (saved_exc);
     }
 
     Py_CLEAR (self->loop);
@@ -412,6 +421,7 @@ finally:
 
     /* Precation, cannot happen */
     if (self->callbacks) g_array_free (self->callbacks, TRUE);
+    self->callbacks = NULL;
 }
 
 static void
@@ -422,9 +432,78 @@ async_dealloc (PyGIAsync *self)
     if (PyObject_CallFinalizerFromDealloc ((PyObject *)self) < 0) return;
 #endif
 
+#ifdef ASYNC_FREELIST_SIZE
+    if (async_freelist_len < ASYNC_FREELIST_SIZE) {
+        async_freelist[async_freelist_len++] = self;
+        return;
+    }
+#endif
+
     Py_TYPE (self)->tp_free ((PyObject *)self);
 }
 
+static PyGIAsync *
+async_alloc (void)
+{
+#ifdef ASYNC_FREELIST_SIZE
+    if (async_freelist_len > 0) {
+        PyGIAsync *self = async_freelist[--async_freelist_len];
+
+        memset ((char *)self + sizeof (PyObject), 0,
+                sizeof (PyGIAsync) - sizeof (PyObject));
+        return (PyGIAsync *)PyObject_Init ((PyObject *)self, &PyGIAsync_Type);
+    }
+#endif
+
+    return (PyGIAsync *)PyGIAsync_Type.tp_alloc (&PyGIAsync_Type, 0);
+}
+
+/**
+ * pygi_async_complete:
+ * @self: (transfer full): the awaitable
+ * @result: (transfer full): the result, or %NULL if an exception is set
+ *
+ * Stores the result of the operation, or the raised exception, and
+ * schedules the done callbacks. Must be called with the GIL held.
+ */
+void
+pygi_async_complete (PyGIAsync *self, PyObject *result)
+{
+    PyObject *ret;
+    guint i;
+
+    if (result == NULL) {
+        /* Already normalized */
+        self->exception = PyErr_GetRaisedException ();
+        self->log_tb = TRUE;
+    } else {
+        self->result = result;
+    }
+
+    for (i = 0; self->callbacks && i < self->callbacks->len; i++) {
+        PyGIAsyncCallback *cb =
+            &g_array_index (self->callbacks, PyGIAsyncCallback, i);
+        /* We stop calling anything after the first exception, but still clear
+         * the internal state as if we did.
+         * This matches the pure python implementation of Future.
+         */
+        if (!PyErr_Occurred ()) {
+            ret = call_soon (self, cb);
+            if (!ret)
+                PyErr_PrintEx (FALSE);
+            else
+                Py_DECREF (ret);
+        }
+
+        Py_DECREF (cb->func);
+        Py_DECREF (cb->context);
+    }
+    if (self->callbacks) g_array_free (self->callbacks, TRUE);
+    self->callbacks = NULL;
+
+    Py_DECREF (self);
+}
+
 void
 pygi_async_finish_cb (GObject *source_object, gpointer res, PyGIAsync *self)
 {
@@ -433,7 +512,7 @@ pygi_async_finish_cb (GObject *source_object, gpointer res, PyGIAsync *self)
     PyObject *args[2];
     size_t nargs;
     PyObject *ret;
-    guint i;
+    gchar *trace_name = NULL;
 
     /* Lock the GIL as we are coming into this code without the lock and we
       may be executing python code */
@@ -445,6 +524,10 @@ pygi_async_finish_cb (GObject *source_object, gpointer res, PyGIAsync *self)
         return;
     }
 
+    PYGI_TRACE_ENTRY (async__finish, trace_name,
+                      _pygi_gi_base_info_get_fullname (
+                          self->finish_func->base.info));
+
     res_pyobj = pygobject_new (res);
     if (source_object) {
         source_pyobj = pygobject_new (source_object);
@@ -468,45 +551,11 @@ pygi_async_finish_cb (GObject *source_object, gpointer res, PyGIAsync *self)
     Py_XDECREF (res_pyobj);
     Py_XDECREF (source_pyobj);
 
-    if (PyErr_Occurred ()) {
-        PyObject *exc = NULL, *value = NULL, *traceback = NULL;
-
-        /* NOTE: cPython >=3.12 has PyErr_{Get,Set}RaisedException */
-        PyErr_Fetch (&exc, &value, &traceback);
-        PyErr_NormalizeException (&exc, &value, &traceback);
-
-        self->exception = value;
-        self->log_tb = TRUE;
+    if (PyErr_Occurred ()) Py_CLEAR (ret);
 
-        Py_XDECREF (exc);
-        Py_XDECREF (traceback);
-        Py_XDECREF (ret);
-    } else {
-        self->result = ret;
-    }
+    pygi_async_complete (self, ret);
 
-    for (i = 0; self->callbacks && i < self->callbacks->len; i++) {
-        PyGIAsyncCallback *cb =
-            &g_array_index (self->callbacks, PyGIAsyncCallback, i);
-        /* We stop calling anything after the first exception, but still clear
-         * the internal state as if we did.
-         * This matches the pure python implementation of Future.
-         */
-        if (!PyErr_Occurred ()) {
-            ret = call_soon (self, cb);
-            if (!ret)
-                PyErr_PrintEx (FALSE);
-            else
-                Py_DECREF (ret);
-        }
-
-        Py_DECREF (cb->func);
-        Py_DECREF (cb->context);
-    }
-    if (self->callbacks) g_array_free (self->callbacks, TRUE);
-    self->callbacks = NULL;
-
-    Py_DECREF (self);
+    PYGI_TRACE_RETURN (async__finish, trace_name);
     PyGILState_Release (py_state);
 }
 
@@ -522,31 +571,23 @@ pygi_async_finish_cb (GObject *source_object, gpointer res, PyGIAsync *self)
 PyObject *
 pygi_async_new (PyObject *finish_func, PyObject *cancellable)
 {
-    PyObject *res;
-    PyObject *args;
+    PyGIAsync *self;
 
-    res = PyGIAsync_Type.tp_alloc (&PyGIAsync_Type, 0);
+    self = async_alloc ();
+    if (self == NULL) return NULL;
 
-    if (res) {
-        if (cancellable && !Py_IsNone (cancellable))
-            args = Py_BuildValue ("(OO)", finish_func, cancellable);
-        else
-            args = Py_BuildValue ("(O)", finish_func);
+    if (cancellable && Py_IsNone (cancellable)) cancellable = NULL;
 
-        if (PyGIAsync_Type.tp_init (res, args, NULL) < 0) {
-            Py_DECREF (args);
-            Py_DECREF (res);
+    if (async_setup (self, finish_func, cancellable) < 0) {
+        Py_DECREF (self);
 
-            /* Ignore exception from object initializer */
-            PyErr_Clear ();
+        /* Ignore exception from object initializer */
+        PyErr_Clear ();
 
-            return NULL;
-        }
-
-        Py_DECREF (args);
+        return NULL;
     }
 
-    return res;
+    return (PyObject *)self;
 }
 
 static struct PyMemberDef async_members[] = {
@@ -631,6 +672,11 @@ pygi_async_register_types (PyObject *module)
     /* Only initialized when really needed! */
     cancellable_info = NULL;
 
+    str_call_soon = PyUnicode_InternFromString ("call_soon");
+    str__context = PyUnicode_InternFromString ("_context");
+    kwnames_context = Py_BuildValue ("(s)", "context");
+    if (!str_call_soon || !str__context || !kwnames_context) goto fail;
+
     Py_CLEAR (asyncio);
     return 0;
 
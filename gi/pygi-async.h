@@ -50,6 +50,8 @@ int pygi_async_register_types (PyObject *d);
 void pygi_async_finish_cb (GObject *source_object, gpointer res,
                            PyGIAsync *async);
 
+void pygi_async_complete (PyGIAsync *self, PyObject *result);
+
 PyObject *pygi_async_new (PyObject *async_finish, PyObject *cancellable);
 
 G_END_DECLS
@@ -27,12 +27,31 @@
 #include "pygi-type.h"
 #include "pygi-util.h"
 
+/* Structs up to this size, owned by the wrapper, are stored in the wrapper
+ * itself instead of a separate allocation. This covers types like
+ * GdkRGBA, graphene_point_t, GtkTreeIter or GValue. */
+#define PYGI_BOXED_INLINE_SIZE 32
+
+typedef union {
+    gint64 v_int64;
+    gdouble v_double;
+    gpointer v_pointer;
+    guint8 data[PYGI_BOXED_INLINE_SIZE];
+} PyGIBoxedInlineData;
+
 struct _PyGIBoxed {
     PyGBoxed base;
     gboolean slice_allocated;
     gsize size;
+    PyGIBoxedInlineData inline_data;
 };
 
+static inline gboolean
+boxed_is_inline (PyGIBoxed *self)
+{
+    return pyg_boxed_get_ptr (self) == (gpointer)&self->inline_data;
+}
+
 static void
 boxed_clear (PyGIBoxed *self)
 {
@@ -40,7 +59,10 @@ boxed_clear (PyGIBoxed *self)
     GType g_type = ((PyGBoxed *)self)->gtype;
 
     if (((PyGBoxed *)self)->free_on_dealloc && boxed != NULL) {
-        if (self->slice_allocated) {
+        if (boxed_is_inline (self)) {
+            if (g_type && g_type_is_a (g_type, G_TYPE_VALUE))
+                g_value_unset (boxed);
+        } else if (self->slice_allocated) {
             if (g_type && g_type_is_a (g_type, G_TYPE_VALUE))
                 g_value_unset (boxed);
             g_slice_free1 (self->size, boxed);
@@ -103,6 +125,25 @@ pygi_boxed_alloc (GIBaseInfo *info, gsize *size_out)
     return boxed;
 }
 
+static gboolean
+boxed_can_inline (GIBaseInfo *info)
+{
+    gsize size, alignment;
+
+    if (GI_IS_UNION_INFO (info)) {
+        size = gi_union_info_get_size ((GIUnionInfo *)info);
+        alignment = gi_union_info_get_alignment ((GIUnionInfo *)info);
+    } else if (GI_IS_STRUCT_INFO (info)) {
+        size = gi_struct_info_get_size ((GIStructInfo *)info);
+        alignment = gi_struct_info_get_alignment ((GIStructInfo *)info);
+    } else {
+        return FALSE;
+    }
+
+    return size > 0 && size <= PYGI_BOXED_INLINE_SIZE
+           && alignment <= G_ALIGNOF (PyGIBoxedInlineData);
+}
+
 static PyObject *
 boxed_new (PyTypeObject *type, PyObject *args, PyObject *kwargs)
 {
@@ -120,6 +161,17 @@ boxed_new (PyTypeObject *type, PyObject *args, PyObject *kwargs)
         return NULL;
     }
 
+    if (boxed_can_inline (info)) {
+        self = (PyGIBoxed *)type->tp_alloc (type, 0);
+        if (self != NULL) {
+            ((PyGBoxed *)self)->gtype =
+                pyg_type_from_object ((PyObject *)type);
+            ((PyGBoxed *)self)->free_on_dealloc = TRUE;
+            pyg_boxed_set_ptr (self, &self->inline_data);
+        }
+        goto out;
+    }
+
     boxed = pygi_boxed_alloc (info, &size);
     if (boxed == NULL) {
         goto out;
@@ -221,6 +273,47 @@ static PyMethodDef boxed_methods[] = {
     { NULL, NULL, 0 },
 };
 
+/* Base of the GLib.Bytes override, exposing the data of the GBytes through
+ * the buffer protocol. Each export holds a reference on the GBytes, so the
+ * memory stays valid even if the wrapper gets cleared. */
+
+PYGI_DEFINE_TYPE ("gi.BytesBoxed", PyGIBytesBoxed_Type, PyGIBoxed);
+
+static int
+bytes_boxed_getbuffer (PyGIBoxed *self, Py_buffer *view, int flags)
+{
+    GBytes *bytes = pyg_boxed_get (self, GBytes);
+    gconstpointer data;
+    gsize size;
+
+    if (bytes == NULL) {
+        PyErr_SetString (PyExc_BufferError, "GLib.Bytes has been cleared");
+        view->obj = NULL;
+        return -1;
+    }
+
+    data = g_bytes_get_data (bytes, &size);
+    if (PyBuffer_FillInfo (view, (PyObject *)self, data ? (void *)data : "",
+                           (Py_ssize_t)size, 1, flags)
+        < 0)
+        return -1;
+
+    view->internal = g_bytes_ref (bytes);
+
+    return 0;
+}
+
+static void
+bytes_boxed_releasebuffer (PyGIBoxed *self, Py_buffer *view)
+{
+    g_bytes_unref (view->internal);
+}
+
+static PyBufferProcs bytes_boxed_as_buffer = {
+    (getbufferproc)bytes_boxed_getbuffer,
+    (releasebufferproc)bytes_boxed_releasebuffer,
+};
+
 /**
  * Returns 0 on success, or -1 and sets an exception.
  */
@@ -243,5 +336,18 @@ pygi_boxed_register_types (PyObject *m)
         return -1;
     }
 
+    Py_SET_TYPE (&PyGIBytesBoxed_Type, &PyType_Type);
+    PyGIBytesBoxed_Type.tp_base = &PyGIBoxed_Type;
+    PyGIBytesBoxed_Type.tp_flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE);
+    PyGIBytesBoxed_Type.tp_as_buffer = &bytes_boxed_as_buffer;
+
+    if (PyType_Ready (&PyGIBytesBoxed_Type) < 0) return -1;
+    Py_INCREF ((PyObject *)&PyGIBytesBoxed_Type);
+    if (PyModule_AddObject (m, "BytesBoxed", (PyObject *)&PyGIBytesBoxed_Type)
+        < 0) {
+        Py_DECREF ((PyObject *)&PyGIBytesBoxed_Type);
+        return -1;
+    }
+
     return 0;
 }
@@ -29,6 +29,7 @@ G_BEGIN_DECLS
 typedef struct _PyGIBoxed PyGIBoxed;
 
 extern PyTypeObject PyGIBoxed_Type;
+extern PyTypeObject PyGIBytesBoxed_Type;
 
 PyObject *pygi_boxed_new (PyTypeObject *type, gpointer boxed,
                           gboolean free_on_dealloc, gsize allocated_slice);
@@ -22,6 +22,7 @@
 #include "pygi-basictype.h"
 #include "pygi-cache-private.h"
 #include "pygi-info.h"
+#include "pygi-struct.h"
 #include "pygi-util.h"
 
 /*
@@ -474,6 +475,18 @@ _wrap_c_array (PyGIInvokeState *state, PyGIArgGArray *array_cache,
                              (guint)array_cache->item_size);
 }
 
+static gboolean
+_is_simple_struct_item (PyGIArgCache *item_cache)
+{
+    PyGIInterfaceCache *iface_cache = (PyGIInterfaceCache *)item_cache;
+
+    return item_cache->type_tag == GI_TYPE_TAG_INTERFACE
+           && !item_cache->is_pointer
+           && GI_IS_STRUCT_INFO (iface_cache->interface_info)
+           && pygi_gi_struct_info_is_simple (
+               (GIStructInfo *)iface_cache->interface_info);
+}
+
 static PyObject *
 _pygi_marshal_to_py_array (PyGIInvokeState *state,
                            PyGICallableCache *callable_cache,
@@ -499,7 +512,19 @@ _pygi_marshal_to_py_array (PyGIInvokeState *state,
         array_ = arg->v_pointer;
     }
 
-    if (seq_cache->item_cache->type_tag == GI_TYPE_TAG_UINT8) {
+    if (state->struct_arrays_as_columns
+        && array_type != GI_ARRAY_TYPE_PTR_ARRAY
+        && _is_simple_struct_item (seq_cache->item_cache)) {
+        PyGIInterfaceCache *iface_cache =
+            (PyGIInterfaceCache *)seq_cache->item_cache;
+
+        py_obj = pygi_struct_array_to_columns (
+            (GIStructInfo *)iface_cache->interface_info,
+            arg->v_pointer ? array_->data : NULL,
+            arg->v_pointer ? array_->len : 0,
+            arg->v_pointer ? g_array_get_element_size (array_) : 0);
+        if (py_obj == NULL) goto err;
+    } else if (seq_cache->item_cache->type_tag == GI_TYPE_TAG_UINT8) {
         if (arg->v_pointer == NULL) {
             py_obj = PyBytes_FromString ("");
         } else {
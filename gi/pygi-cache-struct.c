@@ -371,6 +371,67 @@ pygi_arg_struct_from_py_marshal (PyGIInvokeState *state,
     return TRUE;
 }
 
+/*
+ * GBytes from any object supporting the buffer protocol
+ */
+
+static void
+release_bytes (gpointer data)
+{
+    PyGILState_STATE state;
+
+    /* The last reference to the GBytes can go away from any thread, also
+     * after Python was finalized, in which case the object is leaked. */
+    if (!Py_IsInitialized ()) return;
+
+    state = PyGILState_Ensure ();
+    Py_DECREF ((PyObject *)data);
+    PyGILState_Release (state);
+}
+
+static gboolean
+pygi_arg_gbytes_from_py_marshal (PyGIInvokeState *state,
+                                 PyGICallableCache *callable_cache,
+                                 PyGIArgCache *arg_cache, PyObject *py_arg,
+                                 GIArgument *arg,
+                                 PyGIMarshalCleanupData *cleanup_data)
+{
+    Py_buffer view;
+    GBytes *bytes;
+
+    if (Py_IsNone (py_arg) || PyObject_TypeCheck (py_arg, &PyGBoxed_Type)
+        || !PyObject_CheckBuffer (py_arg)) {
+        return pygi_arg_struct_from_py_marshal (
+            state, callable_cache, arg_cache, py_arg, arg, cleanup_data);
+    }
+
+    if (PyBytes_CheckExact (py_arg)) {
+        /* bytes are immutable, share the data until the GBytes is freed */
+        bytes = g_bytes_new_with_free_func (
+            PyBytes_AS_STRING (py_arg), (gsize)PyBytes_GET_SIZE (py_arg),
+            release_bytes, Py_NewRef (py_arg));
+    } else {
+        /* A read-only buffer can still be changed through another one, so
+         * anything else is copied. */
+        if (PyObject_GetBuffer (py_arg, &view, PyBUF_SIMPLE) == -1)
+            return FALSE;
+
+        bytes = g_bytes_new (view.buf, (gsize)view.len);
+        PyBuffer_Release (&view);
+    }
+
+    pygi_marshal_cleanup_data_init_full (
+        cleanup_data, bytes,
+        arg_cache->transfer == GI_TRANSFER_NOTHING
+            ? (GDestroyNotify)g_bytes_unref
+            : NULL,
+        (GDestroyNotify)g_bytes_unref);
+
+    arg->v_pointer = bytes;
+
+    return TRUE;
+}
+
 static PyObject *
 pygi_arg_gvalue_to_py_marshal (PyGIInvokeState *state,
                                PyGICallableCache *callable_cache,
@@ -531,6 +592,8 @@ arg_struct_from_py_setup (PyGIArgCache *arg_cache,
         arg_cache->from_py_marshaller = pygi_arg_gclosure_from_py_marshal;
     } else if (iface_cache->g_type == G_TYPE_VALUE) {
         arg_cache->from_py_marshaller = pygi_arg_gvalue_from_py_marshal;
+    } else if (iface_cache->g_type == G_TYPE_BYTES) {
+        arg_cache->from_py_marshaller = pygi_arg_gbytes_from_py_marshal;
     } else if (iface_cache->is_foreign) {
         arg_cache->from_py_marshaller = pygi_arg_foreign_from_py_marshal;
     } else {
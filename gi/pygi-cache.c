@@ -805,6 +805,21 @@ pygi_function_cache_new (GICallableInfo *info)
     return function_cache;
 }
 
+/**
+ * pygi_function_cache_can_run_in_pool:
+ *
+ * Whether only the C call of the function can be moved to another thread,
+ * see pygi_callable_info_run_in_pool(). Constructors and vfuncs do more
+ * than marshalling around the call, async functions have to be started
+ * from the thread of their main context.
+ */
+gboolean
+pygi_function_cache_can_run_in_pool (PyGIFunctionCache *function_cache)
+{
+    return function_cache->invoke == _function_cache_invoke_real
+           && function_cache->async_finish == NULL;
+}
+
 PyObject *
 pygi_function_cache_invoke (PyGIFunctionCache *function_cache,
                             PyObject *const *py_args, size_t py_nargsf,
@@ -234,6 +234,9 @@ gboolean pygi_callable_cache_can_throw_gerror (PyGICallableCache *cache);
 
 PyGIFunctionCache *pygi_function_cache_new (GICallableInfo *info);
 
+gboolean
+pygi_function_cache_can_run_in_pool (PyGIFunctionCache *function_cache);
+
 PyObject *pygi_function_cache_invoke (PyGIFunctionCache *function_cache,
                                       PyObject *const *py_args,
                                       size_t py_nargsf, PyObject *py_kwnames);
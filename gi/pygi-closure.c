@@ -24,6 +24,7 @@
 #include "pygi-error.h"
 #include "pygi-invoke.h"
 #include "pygi-marshal-cleanup.h"
+#include "pygi-trace.h"
 
 /* This maintains a list of closures which can be free'd whenever
    as they have been called.  We will free them on the next
@@ -291,52 +292,97 @@ _pygi_closure_convert_ffi_arguments (PyGIInvokeArgState *state,
     }
 }
 
+/* The number of Python arguments the callback is called with at most,
+ * with variable user data args expanded.
+ */
+static gssize
+_pygi_closure_get_n_py_args_max (PyGICClosure *closure)
+{
+    gssize n_py_args = _pygi_callable_cache_args_len (closure->cache);
+
+    if (closure->user_data != NULL && PyTuple_Check (closure->user_data))
+        n_py_args += PyTuple_GET_SIZE (closure->user_data);
+
+    return n_py_args;
+}
+
+/* Sets up the argument state and the Python argument vector for a call.
+ *
+ * Both are allocated once per closure and reused for every following call,
+ * only a reentrant call (e.g. a vfunc calling itself on a child) needs to
+ * allocate its own. The Python argument vector reserves its first element
+ * for PY_VECTORCALL_ARGUMENTS_OFFSET.
+ */
 static gboolean
-_invoke_state_init_from_cache (PyGIInvokeState *state,
-                               PyGIClosureCache *closure_cache, void **args)
+_invoke_state_init_from_cache (PyGIInvokeState *state, PyGICClosure *closure,
+                               void **args, PyObject ***py_args)
 {
-    PyGICallableCache *cache = (PyGICallableCache *)closure_cache;
+    PyGICallableCache *cache = (PyGICallableCache *)closure->cache;
+    gssize n_py_args_max = _pygi_closure_get_n_py_args_max (closure);
 
     state->n_args = _pygi_callable_cache_args_len (cache);
-    state->n_py_in_args = state->n_args;
 
-    /* Increment after setting the number of Python input args */
     if (pygi_callable_cache_can_throw_gerror (cache)) {
         state->n_args++;
     }
 
-    state->py_in_args = PyTuple_New (state->n_py_in_args);
-    if (state->py_in_args == NULL) {
-        PyErr_NoMemory ();
-        return FALSE;
-    }
-
+    state->py_in_args = NULL;
+    state->n_py_in_args = 0;
     state->args = NULL;
+    state->ffi_args = NULL;
     state->error = NULL;
 
-    if (!_pygi_invoke_arg_state_init (state)) {
-        return FALSE;
-    }
+    if (!closure->in_use) {
+        if (closure->py_args == NULL) {
+            closure->args = g_new0 (PyGIInvokeArgState, state->n_args);
+            closure->py_args = g_new0 (PyObject *, n_py_args_max + 1);
+        } else if (state->n_args > 0) {
+            memset (closure->args, 0,
+                    state->n_args * sizeof (PyGIInvokeArgState));
+        }
 
-    state->ffi_args = NULL;
+        closure->in_use = TRUE;
+        state->args = closure->args;
+        *py_args = closure->py_args;
+    } else {
+        if (!_pygi_invoke_arg_state_init (state)) {
+            return FALSE;
+        }
+
+        *py_args = g_new0 (PyObject *, n_py_args_max + 1);
+    }
 
     _pygi_closure_convert_ffi_arguments (state->args, cache, args);
     return TRUE;
 }
 
 static void
-_invoke_state_clear (PyGIInvokeState *state)
+_invoke_state_clear (PyGIInvokeState *state, PyGICClosure *closure,
+                     PyObject **py_args)
 {
-    _pygi_invoke_arg_state_free (state);
-    Py_XDECREF (state->py_in_args);
+    if (py_args == NULL) return;
+
+    for (gssize i = 1; i <= state->n_py_in_args; i++)
+        Py_CLEAR (py_args[i]);
+
+    if (py_args == closure->py_args) {
+        closure->in_use = FALSE;
+    } else {
+        _pygi_invoke_arg_state_free (state);
+        g_free (py_args);
+    }
 }
 
+/* Marshals the arguments for the Python callback into @py_args, starting
+ * at index 1. state->n_py_in_args holds the number of arguments set so
+ * far, also on error.
+ */
 static gboolean
 _pygi_closure_convert_arguments (PyGIInvokeState *state,
-                                 PyGIClosureCache *closure_cache)
+                                 PyGIClosureCache *closure_cache,
+                                 PyObject **py_args)
 {
     PyGICallableCache *cache = (PyGICallableCache *)closure_cache;
-    gssize n_in_args = 0;
 
     for (guint i = 0; i < _pygi_callable_cache_args_len (cache); i++) {
         PyGIArgCache *arg_cache = g_ptr_array_index (cache->args_cache, i);
@@ -350,8 +396,7 @@ _pygi_closure_convert_arguments (PyGIInvokeState *state,
                      * user_data or as the default for user_data in the middle of function
                      * arguments.
                      */
-                    Py_INCREF (Py_None);
-                    value = Py_None;
+                    value = Py_NewRef (Py_None);
                 } else {
                     /* Extend the callbacks args with user_data as variable args. */
                     gssize j, user_data_len;
@@ -364,14 +409,11 @@ _pygi_closure_convert_arguments (PyGIInvokeState *state,
                         return FALSE;
                     }
 
-                    user_data_len = PyTuple_Size (py_user_data);
-                    _PyTuple_Resize (&state->py_in_args,
-                                     state->n_py_in_args + user_data_len - 1);
+                    user_data_len = PyTuple_GET_SIZE (py_user_data);
 
-                    for (j = 0; j < user_data_len; j++, n_in_args++) {
-                        value = PyTuple_GetItem (py_user_data, j);
-                        Py_INCREF (value);
-                        PyTuple_SET_ITEM (state->py_in_args, n_in_args, value);
+                    for (j = 0; j < user_data_len; j++) {
+                        value = PyTuple_GET_ITEM (py_user_data, j);
+                        py_args[++state->n_py_in_args] = Py_NewRef (value);
                     }
                     /* We can assume user_data args are never going to be inout,
                      * so just continue here.
@@ -393,13 +435,10 @@ _pygi_closure_convert_arguments (PyGIInvokeState *state,
                 }
             }
 
-            PyTuple_SET_ITEM (state->py_in_args, n_in_args, value);
-            n_in_args++;
+            py_args[++state->n_py_in_args] = value;
         }
     }
 
-    if (_PyTuple_Resize (&state->py_in_args, n_in_args) == -1) return FALSE;
-
     return TRUE;
 }
 
@@ -514,8 +553,10 @@ _pygi_closure_handle (ffi_cif *cif, void *result, void **args, void *data)
     PyGILState_STATE py_state;
     PyGICClosure *closure = data;
     PyObject *retval;
+    PyObject **py_args = NULL;
     gboolean success = TRUE;
     PyGIInvokeState state = { 0 };
+    gchar *trace_name = NULL;
 
     /* Ignore closures when Python is not initialized. This can happen in cases
      * where calling Python implemented vfuncs can happen at shutdown time.
@@ -530,17 +571,22 @@ _pygi_closure_handle (ffi_cif *cif, void *result, void **args, void *data)
 
     if (closure->cache == NULL) goto end;
 
+    PYGI_TRACE_ENTRY (closure, trace_name,
+                      pygi_callable_cache_get_full_name (closure->cache));
+
     state.user_data = closure->user_data;
 
-    _invoke_state_init_from_cache (&state, closure->cache, args);
+    if (!_invoke_state_init_from_cache (&state, closure, args, &py_args))
+        goto end;
 
-    if (!_pygi_closure_convert_arguments (&state, closure->cache)) {
+    if (!_pygi_closure_convert_arguments (&state, closure->cache, py_args)) {
         _pygi_closure_clear_retvals (&state, closure->cache, result);
         goto end;
     }
 
-    retval =
-        PyObject_CallObject ((PyObject *)closure->function, state.py_in_args);
+    retval = PyObject_Vectorcall (
+        closure->function, py_args + 1,
+        (size_t)state.n_py_in_args | PY_VECTORCALL_ARGUMENTS_OFFSET, NULL);
 
     if (retval == NULL) {
         _pygi_closure_clear_retvals (&state, closure->cache, result);
@@ -562,6 +608,8 @@ end:
 
     if (PyErr_Occurred ()) PyErr_Print ();
 
+    _invoke_state_clear (&state, closure, py_args);
+
     /* Now that the closure has finished we can make a decision about how
        to free it.  Scope call gets free'd at the end of wrap_gi_function_info_invoke.
        Scope notified will be freed when the notify is called.
@@ -592,7 +640,7 @@ end:
         g_assert_not_reached ();
     }
 
-    _invoke_state_clear (&state);
+    PYGI_TRACE_RETURN (closure, trace_name);
     PyGILState_Release (py_state);
 }
 
@@ -609,6 +657,9 @@ _pygi_invoke_closure_free (PyGICClosure *invoke_closure)
 
     _pygi_invoke_closure_clear_py_data (invoke_closure);
 
+    g_free (invoke_closure->args);
+    g_free (invoke_closure->py_args);
+
     g_slice_free (PyGICClosure, invoke_closure);
 }
 
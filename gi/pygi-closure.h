@@ -46,6 +46,12 @@ typedef struct _PyGICClosure {
     PyObject *user_data;
 
     PyGIClosureCache *cache;
+
+    /* Invoke state allocated on the first call and reused by all following
+     * calls which do not reenter the closure. */
+    PyGIInvokeArgState *args;
+    PyObject **py_args;
+    gboolean in_use;
 } PyGICClosure;
 
 void _pygi_invoke_closure_free (PyGICClosure *invoke_closure);
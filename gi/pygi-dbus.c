@@ -0,0 +1,340 @@
+/* -*- Mode: C; c-basic-offset: 4 -*-
+ * vim: tabstop=4 shiftwidth=4 expandtab
+ *
+ *   pygi-dbus.c: exporting Python objects on a GDBusConnection
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pygi-dbus.h"
+
+#include "pygboxed.h"
+#include "pygi-error.h"
+#include "pygi-stream.h"
+#include "pygi-variant.h"
+
+/* Incoming method calls are dispatched by a native GClosure: the parameters
+ * are unpacked in C, the Python method is called with them as positional
+ * arguments and its result is packed into the reply according to the
+ * out-signature, without wrapping the connection, the parameters or the
+ * GDBusMethodInvocation. */
+
+typedef guint (*RegisterObjectFunc) (gpointer connection,
+                                     const gchar *object_path,
+                                     gpointer interface_info,
+                                     GClosure *method_call_closure,
+                                     GClosure *get_property_closure,
+                                     GClosure *set_property_closure,
+                                     GError **error);
+typedef void (*ReturnValueFunc) (gpointer invocation, GVariant *parameters);
+typedef void (*ReturnGErrorFunc) (gpointer invocation, const GError *error);
+typedef void (*ReturnDBusErrorFunc) (gpointer invocation,
+                                     const gchar *error_name,
+                                     const gchar *error_message);
+
+static RegisterObjectFunc register_object;
+static ReturnValueFunc return_value;
+static ReturnGErrorFunc return_gerror;
+static ReturnDBusErrorFunc return_dbus_error;
+static GType dbus_connection_type;
+
+typedef struct {
+    PyObject *callable;
+    GVariantType *out_type;
+} PyGIDBusMethod;
+
+typedef struct {
+    GClosure closure;
+    GHashTable *methods; /* method name -> PyGIDBusMethod */
+} PyGIDBusClosure;
+
+static gboolean
+dbus_functions_init (void)
+{
+    GType invocation_type;
+
+    if (register_object != NULL) return TRUE;
+
+    /* register_object_with_closures() leaks the invocation, see
+     * https://gitlab.gnome.org/GNOME/pygobject/-/issues/756 */
+    register_object = pygi_gio_lookup_method (
+        "DBusConnection", "register_object_with_closures2",
+        &dbus_connection_type);
+    if (register_object == NULL) {
+        PyErr_Clear ();
+        register_object = pygi_gio_lookup_method (
+            "DBusConnection", "register_object_with_closures",
+            &dbus_connection_type);
+    }
+
+    return_value = pygi_gio_lookup_method ("DBusMethodInvocation",
+                                           "return_value", &invocation_type);
+    return_gerror = pygi_gio_lookup_method ("DBusMethodInvocation",
+                                            "return_gerror", &invocation_type);
+    return_dbus_error = pygi_gio_lookup_method (
+        "DBusMethodInvocation", "return_dbus_error", &invocation_type);
+
+    if (return_value == NULL || return_gerror == NULL
+        || return_dbus_error == NULL)
+        register_object = NULL;
+
+    return register_object != NULL;
+}
+
+static void
+dbus_method_free (PyGIDBusMethod *method)
+{
+    Py_DECREF (method->callable);
+    g_variant_type_free (method->out_type);
+    g_free (method);
+}
+
+static void
+dbus_closure_finalize (gpointer data, GClosure *closure)
+{
+    PyGILState_STATE state = PyGILState_Ensure ();
+
+    g_hash_table_unref (((PyGIDBusClosure *)closure)->methods);
+    PyGILState_Release (state);
+}
+
+/* Replies to @invocation with the current Python exception and clears it.
+ * GLib.Error is passed on as is, other exceptions are named after their
+ * type, like dbus-python does. */
+static void
+dbus_return_py_error (gpointer invocation)
+{
+    PyObject *exc = PyErr_GetRaisedException ();
+    GError *error = NULL;
+
+    if (PyErr_GivenExceptionMatches (exc, PyGError)
+        && pygi_error_marshal_from_py (exc, &error)) {
+        return_gerror (invocation, error);
+        g_error_free (error);
+    } else {
+        PyObject *py_message;
+        const char *message = NULL;
+        gchar *name;
+
+        PyErr_Clear ();
+        py_message = PyObject_Str (exc);
+        if (py_message != NULL) message = PyUnicode_AsUTF8 (py_message);
+        if (message == NULL) {
+            PyErr_Clear ();
+            message = "";
+        }
+
+        name = g_strconcat ("org.freedesktop.DBus.Python.",
+                            Py_TYPE (exc)->tp_name, NULL);
+        return_dbus_error (invocation, name, message);
+        g_free (name);
+        Py_XDECREF (py_message);
+    }
+
+    Py_DECREF (exc);
+}
+
+static GVariant *
+dbus_reply_from_py (const GVariantType *out_type, PyObject *result)
+{
+    GVariant *reply;
+    PyObject *items;
+
+    /* The inverse of DBusProxy method calls: no out-args is None, a single
+     * one is returned unboxed. */
+    switch (g_variant_type_n_items (out_type)) {
+    case 0:
+        if (!Py_IsNone (result)) {
+            PyErr_Format (PyExc_TypeError,
+                          "D-Bus method has no out-args, expected None, not "
+                          "%s",
+                          Py_TYPE (result)->tp_name);
+            return NULL;
+        }
+        items = PyTuple_New (0);
+        break;
+    case 1:
+        items = PyTuple_Pack (1, result);
+        break;
+    default:
+        items = Py_NewRef (result);
+        break;
+    }
+
+    if (items == NULL) return NULL;
+
+    reply = pygi_variant_from_py (out_type, items);
+    Py_DECREF (items);
+
+    return reply;
+}
+
+static void
+dbus_closure_marshal (GClosure *closure, GValue *return_gvalue,
+                      guint n_param_values, const GValue *param_values,
+                      gpointer invocation_hint, gpointer marshal_data)
+{
+    PyGIDBusClosure *dbus_closure = (PyGIDBusClosure *)closure;
+    PyGIDBusMethod *method;
+    const gchar *method_name;
+    GVariant *parameters, *reply = NULL;
+    gpointer invocation;
+    PyGILState_STATE state;
+    PyObject *args, *result = NULL;
+
+    g_return_if_fail (n_param_values == 7);
+
+    method_name = g_value_get_string (&param_values[4]);
+    parameters = g_value_get_variant (&param_values[5]);
+    /* The return functions take ownership of the invocation. */
+    invocation = g_value_dup_object (&param_values[6]);
+
+    method = g_hash_table_lookup (dbus_closure->methods, method_name);
+    if (method == NULL) {
+        gchar *message = g_strdup_printf ("No such method '%s'", method_name);
+
+        return_dbus_error (invocation,
+                           "org.freedesktop.DBus.Error.UnknownMethod",
+                           message);
+        g_free (message);
+        return;
+    }
+
+    state = PyGILState_Ensure ();
+
+    args = pygi_variant_to_py (parameters);
+    if (args != NULL) {
+        result = PyObject_CallObject (method->callable, args);
+        Py_DECREF (args);
+    }
+
+    if (result != NULL) {
+        reply = dbus_reply_from_py (method->out_type, result);
+        Py_DECREF (result);
+    }
+
+    if (reply == NULL) dbus_return_py_error (invocation);
+
+    PyGILState_Release (state);
+
+    if (reply != NULL) return_value (invocation, reply);
+}
+
+static GHashTable *
+dbus_methods_from_py (PyObject *py_methods)
+{
+    GHashTable *methods;
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+
+    methods = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                     (GDestroyNotify)dbus_method_free);
+
+    while (PyDict_Next (py_methods, &pos, &key, &value)) {
+        PyGIDBusMethod *method;
+        const char *name, *out_signature;
+        PyObject *callable;
+
+        if (!PyUnicode_Check (key)) {
+            PyErr_Format (PyExc_TypeError,
+                          "method names must be strings, not %s",
+                          Py_TYPE (key)->tp_name);
+            goto error;
+        }
+
+        if (!PyArg_ParseTuple (value, "Os:dbus_connection_export", &callable,
+                               &out_signature))
+            goto error;
+
+        if (!g_variant_type_string_is_valid (out_signature)
+            || !g_variant_type_is_tuple ((const GVariantType *)out_signature)
+            || !g_variant_type_is_definite (
+                (const GVariantType *)out_signature)) {
+            PyErr_Format (PyExc_TypeError, "Invalid out-signature '%s'",
+                          out_signature);
+            goto error;
+        }
+
+        name = PyUnicode_AsUTF8 (key);
+        if (name == NULL) goto error;
+
+        method = g_new (PyGIDBusMethod, 1);
+        method->callable = Py_NewRef (callable);
+        method->out_type = g_variant_type_new (out_signature);
+        g_hash_table_insert (methods, g_strdup (name), method);
+    }
+
+    return methods;
+
+error:
+    g_hash_table_unref (methods);
+    return NULL;
+}
+
+/**
+ * pygi_dbus_connection_export:
+ *
+ * dbus_connection_export(connection, object_path, interface_info, methods)
+ *
+ * @methods maps the D-Bus method names to (callable, out_signature) tuples.
+ * Returns the registration id to pass to DBusConnection.unregister_object().
+ */
+PyObject *
+pygi_dbus_connection_export (PyObject *self, PyObject *args)
+{
+    PyObject *py_connection, *py_interface_info, *py_methods;
+    const char *object_path;
+    gpointer connection;
+    GHashTable *methods;
+    GClosure *closure;
+    guint registration_id;
+    GError *error = NULL;
+
+    if (!PyArg_ParseTuple (args, "OsOO!:dbus_connection_export",
+                           &py_connection, &object_path, &py_interface_info,
+                           &PyDict_Type, &py_methods))
+        return NULL;
+
+    if (!dbus_functions_init ()
+        || !pygi_gio_object_from_py (py_connection, dbus_connection_type,
+                                     "Gio.DBusConnection", FALSE,
+                                     &connection))
+        return NULL;
+
+    if (!pyg_boxed_check (py_interface_info,
+                          g_type_from_name ("GDBusInterfaceInfo"))) {
+        PyErr_Format (PyExc_TypeError, "expected Gio.DBusInterfaceInfo, not %s",
+                      Py_TYPE (py_interface_info)->tp_name);
+        return NULL;
+    }
+
+    methods = dbus_methods_from_py (py_methods);
+    if (methods == NULL) return NULL;
+
+    closure = g_closure_new_simple (sizeof (PyGIDBusClosure), NULL);
+    ((PyGIDBusClosure *)closure)->methods = methods;
+    g_closure_set_marshal (closure, dbus_closure_marshal);
+    g_closure_add_finalize_notifier (closure, NULL, dbus_closure_finalize);
+    g_closure_ref (closure);
+    g_closure_sink (closure);
+
+    registration_id = register_object (
+        connection, object_path, pyg_boxed_get_ptr (py_interface_info),
+        closure, NULL, NULL, &error);
+    g_closure_unref (closure);
+
+    if (pygi_error_check (&error)) return NULL;
+
+    return PyLong_FromUnsignedLong (registration_id);
+}
@@ -28,6 +28,32 @@
 
 PyObject *PyGError = NULL;
 
+static PyObject *str_message;
+static PyObject *str_domain;
+static PyObject *str_code;
+
+/* Interned Python strings for error domains, by quark. Only used with the
+ * GIL held and never freed, like the quarks themselves. */
+static GHashTable *domain_strings;
+
+static PyObject *
+error_domain_to_py (GQuark domain)
+{
+    PyObject *py_domain;
+
+    if (domain == 0) Py_RETURN_NONE;
+
+    py_domain = g_hash_table_lookup (domain_strings, GUINT_TO_POINTER (domain));
+    if (py_domain == NULL) {
+        py_domain = PyUnicode_InternFromString (g_quark_to_string (domain));
+        if (py_domain == NULL) return NULL;
+        g_hash_table_insert (domain_strings, GUINT_TO_POINTER (domain),
+                             py_domain);
+    }
+
+    return Py_NewRef (py_domain);
+}
+
 /**
  * pygi_error_marshal_to_py:
  * @error: a pointer to the GError.
@@ -43,9 +69,10 @@ PyObject *
 pygi_error_marshal_to_py (GError **error)
 {
     PyGILState_STATE state;
-    PyObject *exc_type;
-    PyObject *exc_instance;
-    const char *domain = NULL;
+    PyTypeObject *exc_type;
+    PyObject *exc_instance = NULL;
+    PyObject *args = NULL, *py_domain = NULL, *py_code = NULL;
+    PyObject *py_message;
 
     g_return_val_if_fail (error != NULL, NULL);
 
@@ -53,14 +80,34 @@ pygi_error_marshal_to_py (GError **error)
 
     state = PyGILState_Ensure ();
 
-    exc_type = PyGError;
-
-    if ((*error)->domain) {
-        domain = g_quark_to_string ((*error)->domain);
-    }
-
-    exc_instance = PyObject_CallFunction (exc_type, "ssi", (*error)->message,
-                                          domain, (*error)->code);
+    /* Equivalent to GError(message, domain, code), but without running
+     * GError.__init__() in Python: BaseException.__new__() already sets
+     * args, so only the attributes are left. */
+    if ((*error)->message != NULL)
+        py_message = PyUnicode_FromString ((*error)->message);
+    else
+        py_message = Py_NewRef (Py_None);
+    if (py_message == NULL) goto out;
+
+    args = PyTuple_Pack (1, py_message);
+    py_domain = error_domain_to_py ((*error)->domain);
+    py_code = PyLong_FromLong ((*error)->code);
+    if (args == NULL || py_domain == NULL || py_code == NULL) goto out;
+
+    exc_type = (PyTypeObject *)PyGError;
+    exc_instance = exc_type->tp_new (exc_type, args, NULL);
+    if (exc_instance == NULL) goto out;
+
+    if (PyObject_SetAttr (exc_instance, str_message, py_message) < 0
+        || PyObject_SetAttr (exc_instance, str_domain, py_domain) < 0
+        || PyObject_SetAttr (exc_instance, str_code, py_code) < 0)
+        Py_CLEAR (exc_instance);
+
+out:
+    Py_XDECREF (py_message);
+    Py_XDECREF (args);
+    Py_XDECREF (py_domain);
+    Py_XDECREF (py_code);
 
     PyGILState_Release (state);
 
@@ -128,7 +175,7 @@ pygi_error_marshal_from_py (PyObject *pyerr, GError **error)
         return FALSE;
     }
 
-    py_message = PyObject_GetAttrString (pyerr, "message");
+    py_message = PyObject_GetAttr (pyerr, str_message);
     if (!py_message) {
         PyErr_SetString (
             PyExc_ValueError,
@@ -138,7 +185,7 @@ pygi_error_marshal_from_py (PyObject *pyerr, GError **error)
 
     if (!pygi_utf8_from_py (py_message, &message)) goto cleanup;
 
-    py_domain = PyObject_GetAttrString (pyerr, "domain");
+    py_domain = PyObject_GetAttr (pyerr, str_domain);
     if (!py_domain) {
         PyErr_SetString (
             PyExc_ValueError,
@@ -148,7 +195,7 @@ pygi_error_marshal_from_py (PyObject *pyerr, GError **error)
 
     if (!pygi_utf8_from_py (py_domain, &domain)) goto cleanup;
 
-    py_code = PyObject_GetAttrString (pyerr, "code");
+    py_code = PyObject_GetAttr (pyerr, str_code);
     if (!py_code) {
         PyErr_SetString (
             PyExc_ValueError,
@@ -248,6 +295,13 @@ pygi_error_register_types (PyObject *module)
     Py_DECREF (error_module);
     if (PyGError == NULL) return -1;
 
+    str_message = PyUnicode_InternFromString ("message");
+    str_domain = PyUnicode_InternFromString ("domain");
+    str_code = PyUnicode_InternFromString ("code");
+    if (!str_message || !str_domain || !str_code) return -1;
+
+    domain_strings = g_hash_table_new (NULL, NULL);
+
     pyg_register_gtype_custom (G_TYPE_ERROR, pygerror_from_gvalue,
                                pygerror_to_gvalue);
 
@@ -1254,6 +1254,35 @@ _wrap_gi_function_info_get_finish_func (PyGICallableInfo *self)
     Py_RETURN_NONE;
 }
 
+/* run_in_pool(*args, **kwargs)
+ *
+ * Like calling the function, but the C call happens in a thread pool and a
+ * gi.Async awaitable for the result is returned. See
+ * pygi_callable_info_run_in_pool() for cancellation.
+ */
+static PyObject *
+_wrap_gi_function_info_run_in_pool (PyGICallableInfo *self,
+                                    PyObject *const *args, Py_ssize_t nargs,
+                                    PyObject *kwnames)
+{
+    return pygi_callable_info_run_in_pool (self, args, (size_t)nargs,
+                                           kwnames);
+}
+
+/* call_columnar(*args, **kwargs)
+ *
+ * Like calling the function, but arrays of simple structs in the results are
+ * returned as a dict of memoryviews, one per field.
+ */
+static PyObject *
+_wrap_gi_function_info_call_columnar (PyGICallableInfo *self,
+                                      PyObject *const *args, Py_ssize_t nargs,
+                                      PyObject *kwnames)
+{
+    return pygi_callable_info_invoke_columnar (self, args, (size_t)nargs,
+                                               kwnames);
+}
+
 static PyMethodDef _PyGIFunctionInfo_methods[] = {
     { "is_constructor", (PyCFunction)_wrap_gi_function_info_is_constructor,
       METH_NOARGS },
@@ -1269,6 +1298,10 @@ static PyMethodDef _PyGIFunctionInfo_methods[] = {
       METH_NOARGS },
     { "get_finish_func", (PyCFunction)_wrap_gi_function_info_get_finish_func,
       METH_NOARGS },
+    { "run_in_pool", (PyCFunction)_wrap_gi_function_info_run_in_pool,
+      METH_FASTCALL | METH_KEYWORDS },
+    { "call_columnar", (PyCFunction)_wrap_gi_function_info_call_columnar,
+      METH_FASTCALL | METH_KEYWORDS },
     { NULL, NULL, 0 },
 };
 
@@ -1993,9 +2026,8 @@ _pygi_gi_registered_type_info_check_object (GIRegisteredTypeInfo *info,
 }
 
 static PyObject *
-_wrap_gi_field_info_get_value (PyGIBaseInfo *self, PyObject *args)
+field_info_get_value (GIBaseInfo *field_info, PyObject *instance)
 {
-    PyObject *instance;
     GIBaseInfo *container_info;
     gpointer container;
     GITypeInfo *field_type_info;
@@ -2003,11 +2035,7 @@ _wrap_gi_field_info_get_value (PyGIBaseInfo *self, PyObject *args)
     PyObject *py_value = NULL;
     gsize array_length;
 
-    if (!PyArg_ParseTuple (args, "O:FieldInfo.get_value", &instance)) {
-        return NULL;
-    }
-
-    container_info = gi_base_info_get_container (self->info); /* borrowed! */
+    container_info = gi_base_info_get_container (field_info); /* borrowed! */
     g_assert (container_info != NULL);
 
     /* Check the instance. */
@@ -2039,14 +2067,14 @@ _wrap_gi_field_info_get_value (PyGIBaseInfo *self, PyObject *args)
     }
 
     /* Get the field's value. */
-    field_type_info = gi_field_info_get_type_info (GI_FIELD_INFO (self->info));
+    field_type_info = gi_field_info_get_type_info (GI_FIELD_INFO (field_info));
 
     /* A few types are not handled by gi_field_info_get_field, so do it here. */
     if (!gi_type_info_is_pointer (field_type_info)
         && gi_type_info_get_tag (field_type_info) == GI_TYPE_TAG_INTERFACE) {
         GIBaseInfo *interface_info;
 
-        if (!(gi_field_info_get_flags ((GIFieldInfo *)self->info)
+        if (!(gi_field_info_get_flags ((GIFieldInfo *)field_info)
               & GI_FIELD_IS_READABLE)) {
             PyErr_SetString (PyExc_RuntimeError, "field is not readable");
             goto out;
@@ -2064,7 +2092,7 @@ _wrap_gi_field_info_get_value (PyGIBaseInfo *self, PyObject *args)
         case PYGI_INTERFACE_TYPE_TAG_STRUCT: {
             gsize offset;
 
-            offset = gi_field_info_get_offset ((GIFieldInfo *)self->info);
+            offset = gi_field_info_get_offset ((GIFieldInfo *)field_info);
 
             value.v_pointer = (char *)container + offset;
 
@@ -2084,14 +2112,14 @@ _wrap_gi_field_info_get_value (PyGIBaseInfo *self, PyObject *args)
         }
     }
 
-    if (!gi_field_info_get_field ((GIFieldInfo *)self->info, container,
+    if (!gi_field_info_get_field ((GIFieldInfo *)field_info, container,
                                   &value)) {
         PyErr_SetString (PyExc_RuntimeError, "unable to get the value");
         goto out;
     }
 
 argument_to_object:
-    if (field_array_length (GI_FIELD_INFO (self->info), container,
+    if (field_array_length (GI_FIELD_INFO (field_info), container,
                             &array_length))
         py_value = pygi_argument_to_py_with_array_length (
             field_type_info, value, GI_TRANSFER_NOTHING, array_length);
@@ -2106,23 +2134,17 @@ out:
 }
 
 static PyObject *
-_wrap_gi_field_info_set_value (PyGIBaseInfo *self, PyObject *args)
+field_info_set_value (GIBaseInfo *field_info, PyObject *instance,
+                      PyObject *py_value)
 {
     PyGIArgumentFromPyCleanupData arg_cleanup = { 0 };
-    PyObject *instance;
-    PyObject *py_value;
     GIBaseInfo *container_info;
     gpointer pointer;
     GITypeInfo *field_type_info;
     GIArgument value;
     PyObject *retval = NULL;
 
-    if (!PyArg_ParseTuple (args, "OO:FieldInfo.set_value", &instance,
-                           &py_value)) {
-        return NULL;
-    }
-
-    container_info = gi_base_info_get_container (self->info);
+    container_info = gi_base_info_get_container (field_info);
     g_assert (container_info != NULL);
 
     /* Check the instance. */
@@ -2153,7 +2175,7 @@ _wrap_gi_field_info_set_value (PyGIBaseInfo *self, PyObject *args)
         return NULL;
     }
 
-    field_type_info = gi_field_info_get_type_info ((GIFieldInfo *)self->info);
+    field_type_info = gi_field_info_get_type_info ((GIFieldInfo *)field_info);
 
     /* Set the field's value. */
     /* A few types are not handled by gi_field_info_set_field, so do it here. */
@@ -2161,7 +2183,7 @@ _wrap_gi_field_info_set_value (PyGIBaseInfo *self, PyObject *args)
         && gi_type_info_get_tag (field_type_info) == GI_TYPE_TAG_INTERFACE) {
         GIBaseInfo *info;
 
-        if (!(gi_field_info_get_flags ((GIFieldInfo *)self->info)
+        if (!(gi_field_info_get_flags ((GIFieldInfo *)field_info)
               & GI_FIELD_IS_WRITABLE)) {
             PyErr_SetString (PyExc_RuntimeError, "field is not writable");
             goto out;
@@ -2196,7 +2218,7 @@ _wrap_gi_field_info_set_value (PyGIBaseInfo *self, PyObject *args)
                 goto out;
             }
 
-            offset = gi_field_info_get_offset ((GIFieldInfo *)self->info);
+            offset = gi_field_info_get_offset ((GIFieldInfo *)field_info);
             size = gi_struct_info_get_size ((GIStructInfo *)info);
             g_assert (size > 0);
 
@@ -2227,7 +2249,7 @@ _wrap_gi_field_info_set_value (PyGIBaseInfo *self, PyObject *args)
             goto out;
         }
 
-        offset = gi_field_info_get_offset ((GIFieldInfo *)self->info);
+        offset = gi_field_info_get_offset ((GIFieldInfo *)field_info);
         G_STRUCT_MEMBER (gpointer, pointer, offset) =
             (gpointer)value.v_pointer;
 
@@ -2241,7 +2263,7 @@ _wrap_gi_field_info_set_value (PyGIBaseInfo *self, PyObject *args)
         goto out;
     }
 
-    if (!gi_field_info_set_field ((GIFieldInfo *)self->info, pointer,
+    if (!gi_field_info_set_field ((GIFieldInfo *)field_info, pointer,
                                   &value)) {
         PyErr_SetString (PyExc_RuntimeError, "unable to set value for field");
         goto out;
@@ -2257,6 +2279,32 @@ out:
     return retval;
 }
 
+static PyObject *
+_wrap_gi_field_info_get_value (PyGIBaseInfo *self, PyObject *args)
+{
+    PyObject *instance;
+
+    if (!PyArg_ParseTuple (args, "O:FieldInfo.get_value", &instance)) {
+        return NULL;
+    }
+
+    return field_info_get_value (self->info, instance);
+}
+
+static PyObject *
+_wrap_gi_field_info_set_value (PyGIBaseInfo *self, PyObject *args)
+{
+    PyObject *instance;
+    PyObject *py_value;
+
+    if (!PyArg_ParseTuple (args, "OO:FieldInfo.set_value", &instance,
+                           &py_value)) {
+        return NULL;
+    }
+
+    return field_info_set_value (self->info, instance, py_value);
+}
+
 static PyObject *
 _wrap_gi_field_info_get_flags (PyGIBaseInfo *self)
 {
@@ -2297,6 +2345,288 @@ static PyMethodDef _PyGIFieldInfo_methods[] = {
     { NULL, NULL, 0 },
 };
 
+/* FieldDescriptor
+ *
+ * Attribute descriptor installed on struct, union and object classes for
+ * each of their fields. Scalar fields of structs and unions are read and
+ * written directly at their offset, everything else goes through
+ * field_info_get_value() and field_info_set_value().
+ */
+typedef struct {
+    PyObject_HEAD
+    GIBaseInfo *info;
+    PyTypeObject *owner;
+    gsize offset;
+    GITypeTag type_tag; /* GI_TYPE_TAG_VOID if there is no fast path */
+    GIFieldInfoFlags flags;
+} PyGIFieldDescriptor;
+
+PYGI_DEFINE_TYPE ("gi.FieldDescriptor", PyGIFieldDescriptor_Type,
+                  PyGIFieldDescriptor);
+
+static GITypeTag
+field_descriptor_scalar_tag (GIFieldInfo *info)
+{
+    GIBaseInfo *container_info;
+    GITypeInfo *type_info;
+    GITypeTag type_tag = GI_TYPE_TAG_VOID;
+
+    container_info = gi_base_info_get_container ((GIBaseInfo *)info);
+    if (!GI_IS_UNION_INFO (container_info)
+        && !(GI_IS_STRUCT_INFO (container_info)
+             && !gi_struct_info_is_foreign ((GIStructInfo *)container_info)))
+        return GI_TYPE_TAG_VOID;
+
+    /* Bitfields need masking, leave them to gi_field_info_get_field(). */
+    if (gi_field_info_get_size (info) != 0) return GI_TYPE_TAG_VOID;
+
+    type_info = gi_field_info_get_type_info (info);
+    if (!gi_type_info_is_pointer (type_info)) {
+        switch (gi_type_info_get_tag (type_info)) {
+        case GI_TYPE_TAG_BOOLEAN:
+        case GI_TYPE_TAG_INT8:
+        case GI_TYPE_TAG_UINT8:
+        case GI_TYPE_TAG_INT16:
+        case GI_TYPE_TAG_UINT16:
+        case GI_TYPE_TAG_INT32:
+        case GI_TYPE_TAG_UINT32:
+        case GI_TYPE_TAG_INT64:
+        case GI_TYPE_TAG_UINT64:
+        case GI_TYPE_TAG_FLOAT:
+        case GI_TYPE_TAG_DOUBLE:
+        case GI_TYPE_TAG_GTYPE:
+        case GI_TYPE_TAG_UNICHAR:
+            type_tag = gi_type_info_get_tag (type_info);
+            break;
+        case GI_TYPE_TAG_VOID:
+        case GI_TYPE_TAG_UTF8:
+        case GI_TYPE_TAG_FILENAME:
+        case GI_TYPE_TAG_ARRAY:
+        case GI_TYPE_TAG_INTERFACE:
+        case GI_TYPE_TAG_GLIST:
+        case GI_TYPE_TAG_GSLIST:
+        case GI_TYPE_TAG_GHASH:
+        case GI_TYPE_TAG_ERROR:
+            break;
+        default:
+            g_assert_not_reached ();
+        }
+    }
+    gi_base_info_unref ((GIBaseInfo *)type_info);
+
+    return type_tag;
+}
+
+static PyObject *
+field_descriptor_new (PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = { "field_info", "owner", NULL };
+    PyGIBaseInfo *py_info;
+    PyTypeObject *owner;
+    PyGIFieldDescriptor *self;
+
+    if (!PyArg_ParseTupleAndKeywords (args, kwargs, "O!O!:FieldDescriptor",
+                                      kwlist, &PyGIFieldInfo_Type, &py_info,
+                                      &PyType_Type, &owner))
+        return NULL;
+
+    self = (PyGIFieldDescriptor *)type->tp_alloc (type, 0);
+    if (!self) return NULL;
+
+    self->info = gi_base_info_ref (py_info->info);
+    self->owner = (PyTypeObject *)Py_NewRef ((PyObject *)owner);
+    self->offset = gi_field_info_get_offset ((GIFieldInfo *)self->info);
+    self->type_tag = field_descriptor_scalar_tag ((GIFieldInfo *)self->info);
+    self->flags = gi_field_info_get_flags ((GIFieldInfo *)self->info);
+
+    return (PyObject *)self;
+}
+
+static int
+field_descriptor_traverse (PyGIFieldDescriptor *self, visitproc visit,
+                           void *arg)
+{
+    Py_VISIT (self->owner);
+    return 0;
+}
+
+static int
+field_descriptor_clear (PyGIFieldDescriptor *self)
+{
+    Py_CLEAR (self->owner);
+    return 0;
+}
+
+static void
+field_descriptor_dealloc (PyGIFieldDescriptor *self)
+{
+    PyObject_GC_UnTrack (self);
+    field_descriptor_clear (self);
+    gi_base_info_unref (self->info);
+    Py_TYPE (self)->tp_free ((PyObject *)self);
+}
+
+/* Returns the struct memory if @instance can use the fast path. */
+static gpointer
+field_descriptor_get_container (PyGIFieldDescriptor *self, PyObject *instance)
+{
+    if (self->type_tag == GI_TYPE_TAG_VOID
+        || !PyObject_TypeCheck (instance, self->owner))
+        return NULL;
+
+    return pyg_boxed_get_ptr (instance);
+}
+
+static PyObject *
+field_descriptor_get (PyGIFieldDescriptor *self, PyObject *instance,
+                      PyObject *owner)
+{
+    GIArgument arg = PYGI_ARG_INIT;
+    gpointer field;
+
+    if (instance == NULL || instance == Py_None)
+        return Py_NewRef ((PyObject *)self);
+
+    if (!(self->flags & GI_FIELD_IS_READABLE)
+        || !(field = field_descriptor_get_container (self, instance)))
+        return field_info_get_value (self->info, instance);
+
+    field = (char *)field + self->offset;
+
+    switch (self->type_tag) {
+    case GI_TYPE_TAG_BOOLEAN:
+        arg.v_boolean = *(gboolean *)field;
+        break;
+    case GI_TYPE_TAG_INT8:
+    case GI_TYPE_TAG_UINT8:
+        arg.v_uint8 = *(guint8 *)field;
+        break;
+    case GI_TYPE_TAG_INT16:
+    case GI_TYPE_TAG_UINT16:
+        arg.v_uint16 = *(guint16 *)field;
+        break;
+    case GI_TYPE_TAG_INT32:
+    case GI_TYPE_TAG_UINT32:
+    case GI_TYPE_TAG_UNICHAR:
+        arg.v_uint32 = *(guint32 *)field;
+        break;
+    case GI_TYPE_TAG_INT64:
+    case GI_TYPE_TAG_UINT64:
+        arg.v_uint64 = *(guint64 *)field;
+        break;
+    case GI_TYPE_TAG_FLOAT:
+        arg.v_float = *(gfloat *)field;
+        break;
+    case GI_TYPE_TAG_DOUBLE:
+        arg.v_double = *(gdouble *)field;
+        break;
+    case GI_TYPE_TAG_GTYPE:
+        arg.v_size = *(GType *)field;
+        break;
+    /* Only scalar fields get a type tag, see field_descriptor_scalar_tag() */
+    case GI_TYPE_TAG_VOID:
+    case GI_TYPE_TAG_UTF8:
+    case GI_TYPE_TAG_FILENAME:
+    case GI_TYPE_TAG_ARRAY:
+    case GI_TYPE_TAG_INTERFACE:
+    case GI_TYPE_TAG_GLIST:
+    case GI_TYPE_TAG_GSLIST:
+    case GI_TYPE_TAG_GHASH:
+    case GI_TYPE_TAG_ERROR:
+    default:
+        g_assert_not_reached ();
+    }
+
+    return pygi_marshal_to_py_basic_type (arg, self->type_tag,
+                                          GI_TRANSFER_NOTHING);
+}
+
+static int
+field_descriptor_set (PyGIFieldDescriptor *self, PyObject *instance,
+                      PyObject *value)
+{
+    GIArgument arg;
+    gpointer cleanup_data = NULL;
+    gpointer field;
+    PyObject *retval;
+
+    if (value == NULL) {
+        PyErr_SetString (PyExc_AttributeError, "can't delete attribute");
+        return -1;
+    }
+
+    if (!(self->flags & GI_FIELD_IS_WRITABLE)
+        || !(field = field_descriptor_get_container (self, instance))) {
+        retval = field_info_set_value (self->info, instance, value);
+        if (!retval) return -1;
+        Py_DECREF (retval);
+        return 0;
+    }
+
+    arg = pygi_marshal_from_py_basic_type (value, self->type_tag,
+                                           GI_TRANSFER_NOTHING, &cleanup_data);
+    if (PyErr_Occurred ()) return -1;
+
+    field = (char *)field + self->offset;
+
+    switch (self->type_tag) {
+    case GI_TYPE_TAG_BOOLEAN:
+        *(gboolean *)field = arg.v_boolean;
+        break;
+    case GI_TYPE_TAG_INT8:
+    case GI_TYPE_TAG_UINT8:
+        *(guint8 *)field = arg.v_uint8;
+        break;
+    case GI_TYPE_TAG_INT16:
+    case GI_TYPE_TAG_UINT16:
+        *(guint16 *)field = arg.v_uint16;
+        break;
+    case GI_TYPE_TAG_INT32:
+    case GI_TYPE_TAG_UINT32:
+    case GI_TYPE_TAG_UNICHAR:
+        *(guint32 *)field = arg.v_uint32;
+        break;
+    case GI_TYPE_TAG_INT64:
+    case GI_TYPE_TAG_UINT64:
+        *(guint64 *)field = arg.v_uint64;
+        break;
+    case GI_TYPE_TAG_FLOAT:
+        *(gfloat *)field = arg.v_float;
+        break;
+    case GI_TYPE_TAG_DOUBLE:
+        *(gdouble *)field = arg.v_double;
+        break;
+    case GI_TYPE_TAG_GTYPE:
+        *(GType *)field = arg.v_size;
+        break;
+    /* Only scalar fields get a type tag, see field_descriptor_scalar_tag() */
+    case GI_TYPE_TAG_VOID:
+    case GI_TYPE_TAG_UTF8:
+    case GI_TYPE_TAG_FILENAME:
+    case GI_TYPE_TAG_ARRAY:
+    case GI_TYPE_TAG_INTERFACE:
+    case GI_TYPE_TAG_GLIST:
+    case GI_TYPE_TAG_GSLIST:
+    case GI_TYPE_TAG_GHASH:
+    case GI_TYPE_TAG_ERROR:
+    default:
+        g_assert_not_reached ();
+    }
+
+    return 0;
+}
+
+static PyObject *
+field_descriptor_get_field_info (PyGIFieldDescriptor *self, void *closure)
+{
+    return _pygi_info_new (self->info);
+}
+
+static PyGetSetDef _PyGIFieldDescriptor_getsets[] = {
+    { "field_info", (getter)field_descriptor_get_field_info, NULL },
+    { NULL, NULL, NULL },
+};
+
 
 /* GIUnresolvedInfo */
 PYGI_DEFINE_TYPE ("gi.UnresolvedInfo", PyGIUnresolvedInfo_Type, PyGIBaseInfo);
@@ -2507,6 +2837,27 @@ pygi_info_register_types (PyObject *m)
 
 #undef _PyGI_REGISTER_TYPE
 
+    Py_SET_TYPE (&PyGIFieldDescriptor_Type, &PyType_Type);
+    PyGIFieldDescriptor_Type.tp_flags = (Py_TPFLAGS_DEFAULT
+                                         | Py_TPFLAGS_HAVE_GC);
+    PyGIFieldDescriptor_Type.tp_new = field_descriptor_new;
+    PyGIFieldDescriptor_Type.tp_dealloc = (destructor)field_descriptor_dealloc;
+    PyGIFieldDescriptor_Type.tp_traverse =
+        (traverseproc)field_descriptor_traverse;
+    PyGIFieldDescriptor_Type.tp_clear = (inquiry)field_descriptor_clear;
+    PyGIFieldDescriptor_Type.tp_free = PyObject_GC_Del;
+    PyGIFieldDescriptor_Type.tp_descr_get = (descrgetfunc)field_descriptor_get;
+    PyGIFieldDescriptor_Type.tp_descr_set = (descrsetfunc)field_descriptor_set;
+    PyGIFieldDescriptor_Type.tp_getset = _PyGIFieldDescriptor_getsets;
+    if (PyType_Ready (&PyGIFieldDescriptor_Type) < 0) return -1;
+    Py_INCREF ((PyObject *)&PyGIFieldDescriptor_Type);
+    if (PyModule_AddObject (m, "FieldDescriptor",
+                            (PyObject *)&PyGIFieldDescriptor_Type)
+        < 0) {
+        Py_DECREF ((PyObject *)&PyGIFieldDescriptor_Type);
+        return -1;
+    }
+
 #define _PyGI_ENUM_BEGIN(name)                                                \
     {                                                                         \
         const char *__enum_name = #name;                                      \
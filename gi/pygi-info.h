@@ -55,6 +55,7 @@ extern PyTypeObject PyGIInterfaceInfo_Type;
 extern PyTypeObject PyGIConstantInfo_Type;
 extern PyTypeObject PyGIValueInfo_Type;
 extern PyTypeObject PyGIFieldInfo_Type;
+extern PyTypeObject PyGIFieldDescriptor_Type;
 extern PyTypeObject PyGIUnresolvedInfo_Type;
 extern PyTypeObject PyGIVFuncInfo_Type;
 extern PyTypeObject PyGIUnionInfo_Type;
@@ -64,6 +64,16 @@ typedef struct _PyGIInvokeState {
 
     gpointer user_data;
 
+    /* Return arrays of simple structs as columns, see
+     * pygi_struct_array_to_columns().
+     */
+    gboolean struct_arrays_as_columns;
+
+    /* The Gio.Cancellable of the run_in_pool() awaitable, passed for
+     * cancellable arguments left as None or default.
+     */
+    PyObject *pool_cancellable;
+
     /* Function pointer to call with ffi. */
     gpointer function_ptr;
 
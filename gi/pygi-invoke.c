@@ -29,6 +29,7 @@
 #include "pygi-foreign.h"
 #include "pygi-marshal-cleanup.h"
 #include "pygi-resulttuple.h"
+#include "pygi-trace.h"
 
 extern PyObject *_PyGIDefaultArgPlaceholder;
 
@@ -534,6 +535,11 @@ _invoke_marshal_in_args (PyGIInvokeState *state,
             g_assert_not_reached ();
         }
 
+        if (state->pool_cancellable != NULL
+            && arg_cache->async_context == PYGI_ASYNC_CONTEXT_CANCELLABLE
+            && (py_arg == _PyGIDefaultArgPlaceholder || Py_IsNone (py_arg)))
+            py_arg = state->pool_cancellable;
+
         if (py_arg == _PyGIDefaultArgPlaceholder) {
             /* If this is the cancellable, then we may override it later if we
              * detect an async call.
@@ -681,9 +687,12 @@ pygi_invoke_c_callable (PyGIFunctionCache *function_cache,
     PyGICallableCache *cache = (PyGICallableCache *)function_cache;
     GIFFIReturnValue ffi_return_value = PYGI_ARG_INIT;
     PyObject *ret = NULL;
+    gchar *trace_name = NULL;
 
     if (Py_EnterRecursiveCall (" while calling a GICallable")) return NULL;
-    ;
+
+    PYGI_TRACE_ENTRY (invoke, trace_name,
+                      pygi_callable_cache_get_full_name (cache));
 
     if (!_invoke_state_init_from_cache (state, function_cache, py_args,
                                         py_nargsf, py_kwnames))
@@ -726,6 +735,7 @@ pygi_invoke_c_callable (PyGIFunctionCache *function_cache,
 
 err:
     _invoke_state_clear (state, function_cache);
+    PYGI_TRACE_RETURN (invoke, trace_name);
     Py_LeaveRecursiveCall ();
     return ret;
 }
@@ -740,3 +750,172 @@ pygi_callable_info_invoke (PyGICallableInfo *self, PyObject *const *py_args,
 
     return pygi_function_cache_invoke (cache, py_args, py_nargsf, py_kwnames);
 }
+
+/**
+ * pygi_callable_info_invoke_columnar:
+ *
+ * Like pygi_callable_info_invoke(), but arrays of simple structs are
+ * returned as columns, see pygi_struct_array_to_columns().
+ */
+PyObject *
+pygi_callable_info_invoke_columnar (PyGICallableInfo *self,
+                                    PyObject *const *py_args,
+                                    size_t py_nargsf, PyObject *py_kwnames)
+{
+    PyGIFunctionCache *cache = pygi_callable_info_get_cache (self);
+    PyGIInvokeState state = { 0 };
+
+    if (cache == NULL) return NULL;
+
+    state.struct_arrays_as_columns = TRUE;
+
+    return cache->invoke (cache, &state, py_args, py_nargsf, py_kwnames);
+}
+
+/* A call of pygi_callable_info_run_in_pool(). The arguments are marshalled
+ * on the calling thread, only ffi_call() runs in the pool, and the results
+ * are marshalled back from an idle source in the main context of the
+ * awaitable. */
+typedef struct {
+    PyGIInvokeState state;
+    PyGICallableInfo *info; /* keeps the function cache alive */
+    GIFFIReturnValue ffi_return_value;
+    PyGIAsync *async;
+    GMainContext *context;
+} PyGIPoolCall;
+
+static GThreadPool *invoke_pool;
+
+static gboolean
+pool_call_complete (gpointer data)
+{
+    PyGIPoolCall *call = data;
+    PyGIInvokeState *state = &call->state;
+    PyGIFunctionCache *function_cache = call->info->cache;
+    PyGICallableCache *cache = (PyGICallableCache *)function_cache;
+    PyGILState_STATE py_state;
+    PyObject *ret = NULL;
+
+    py_state = PyGILState_Ensure ();
+
+    if (state->error != NULL && pygi_error_check (&state->error)) {
+        pygi_marshal_cleanup_args_from_py (state, cache, /*success=*/TRUE);
+    } else {
+        if (cache->return_cache) {
+            gi_type_info_extract_ffi_return_value (
+                cache->return_cache->type_info, &call->ffi_return_value,
+                &state->return_arg);
+        }
+
+        ret = _invoke_marshal_out_args (state, function_cache);
+        pygi_marshal_cleanup_args_from_py (state, cache, /*success=*/TRUE);
+        pygi_marshal_cleanup_args_to_py (state, cache,
+                                         /*success=*/ret != NULL);
+    }
+
+    _invoke_state_clear (state, function_cache);
+    pygi_async_complete (call->async, ret);
+    Py_DECREF (call->info);
+
+    PyGILState_Release (py_state);
+
+    g_main_context_unref (call->context);
+    g_free (call);
+
+    return G_SOURCE_REMOVE;
+}
+
+static void
+pool_call_run (gpointer data, gpointer user_data)
+{
+    PyGIPoolCall *call = data;
+    GSource *source;
+
+    ffi_call (&call->info->cache->invoker.cif, call->state.function_ptr,
+              (void *)&call->ffi_return_value, (void **)call->state.ffi_args);
+
+    source = g_idle_source_new ();
+    g_source_set_priority (source, G_PRIORITY_DEFAULT);
+    g_source_set_callback (source, pool_call_complete, call, NULL);
+    g_source_set_static_name (source, "PyGObject pool call");
+    g_source_attach (source, call->context);
+    g_source_unref (source);
+}
+
+/**
+ * pygi_callable_info_run_in_pool:
+ *
+ * Calls the function with the given arguments in a thread pool and returns
+ * a gi.Async awaitable for its result. A GCancellable argument left as None
+ * or default is set to the cancellable of the awaitable, so cancelling the
+ * awaitable cancels the call. Without one, cancelling only takes effect once
+ * the call returned.
+ *
+ * Returns: the awaitable, or %NULL with an exception set.
+ */
+PyObject *
+pygi_callable_info_run_in_pool (PyGICallableInfo *self,
+                                PyObject *const *py_args, size_t py_nargsf,
+                                PyObject *py_kwnames)
+{
+    PyGIFunctionCache *function_cache;
+    PyGIPoolCall *call;
+    PyObject *async;
+    GError *error = NULL;
+
+    function_cache = pygi_callable_info_get_cache (self);
+    if (function_cache == NULL) return NULL;
+
+    if (!pygi_function_cache_can_run_in_pool (function_cache)) {
+        gchar *full_name = pygi_callable_cache_get_full_name (
+            (PyGICallableCache *)function_cache);
+        PyErr_Format (PyExc_TypeError, "%s() can't be run in a thread pool",
+                      full_name);
+        g_free (full_name);
+        return NULL;
+    }
+
+    if (G_UNLIKELY (invoke_pool == NULL)) {
+        invoke_pool = g_thread_pool_new (pool_call_run, NULL,
+                                         (gint)g_get_num_processors (), FALSE,
+                                         &error);
+        if (pygi_error_check (&error)) return NULL;
+    }
+
+    async = pygi_async_new ((PyObject *)self, NULL);
+    if (async == NULL) {
+        PyErr_SetString (PyExc_RuntimeError,
+                         "run_in_pool() requires a running GLib event loop");
+        return NULL;
+    }
+
+    call = g_new0 (PyGIPoolCall, 1);
+
+    if (!_invoke_state_init_from_cache (&call->state, function_cache, py_args,
+                                        py_nargsf, py_kwnames))
+        goto err;
+
+    /* Borrowed, call->async keeps it alive */
+    call->state.pool_cancellable = ((PyGIAsync *)async)->cancellable;
+
+    if (!_invoke_marshal_in_args (&call->state, function_cache)) {
+        pygi_marshal_cleanup_args_from_py (
+            &call->state, (PyGICallableCache *)function_cache,
+            /*success=*/FALSE);
+        goto err;
+    }
+
+    call->info = (PyGICallableInfo *)Py_NewRef (self);
+    call->async = (PyGIAsync *)Py_NewRef (async);
+    call->context = g_main_context_ref_thread_default ();
+
+    g_thread_pool_push (invoke_pool, call, NULL);
+
+    return async;
+
+err:
+    _invoke_state_clear (&call->state, function_cache);
+    g_free (call);
+    Py_DECREF (async);
+    return NULL;
+}
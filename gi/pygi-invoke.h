@@ -31,6 +31,16 @@ PyObject *pygi_callable_info_invoke (PyGICallableInfo *self,
                                      PyObject *const *py_args,
                                      size_t py_nargsf, PyObject *kwnames);
 
+PyObject *pygi_callable_info_invoke_columnar (PyGICallableInfo *self,
+                                              PyObject *const *py_args,
+                                              size_t py_nargsf,
+                                              PyObject *py_kwnames);
+
+PyObject *pygi_callable_info_run_in_pool (PyGICallableInfo *self,
+                                          PyObject *const *py_args,
+                                          size_t py_nargsf,
+                                          PyObject *py_kwnames);
+
 gboolean _pygi_invoke_arg_state_init (PyGIInvokeState *state);
 
 void _pygi_invoke_arg_state_free (PyGIInvokeState *state);
@@ -21,7 +21,10 @@
 #include "pygi-util.h"
 
 static char repr_format_key[] = "__repr_format";
-static char tuple_indices_key[] = "__tuple_indices";
+
+/* Result tuple types by their tuple of item names, shared between all
+ * callables with the same out-argument names. */
+static PyObject *resulttuple_types;
 
 #define PYGI_USE_FREELIST
 
@@ -43,6 +46,50 @@ static int numfree[PyGIResultTuple_MAXSAVESIZE];
 
 PYGI_DEFINE_TYPE ("gi._gi.ResultTuple", PyGIResultTuple_Type, PyTupleObject)
 
+/* Descriptor for a named item, created once per name when the result tuple
+ * type is created. */
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t index;
+} PyGIResultTupleField;
+
+PYGI_DEFINE_TYPE ("gi._gi.ResultTupleField", PyGIResultTupleField_Type,
+                  PyGIResultTupleField)
+
+static PyObject *
+resulttuple_field_descr_get (PyGIResultTupleField *self, PyObject *obj,
+                             PyObject *type)
+{
+    PyObject *item;
+
+    if (obj == NULL) return Py_NewRef (self);
+
+    if (!PyTuple_Check (obj) || self->index >= PyTuple_GET_SIZE (obj)) {
+        PyErr_Format (PyExc_TypeError,
+                      "descriptor for item %zd doesn't apply to a '%s' "
+                      "object",
+                      self->index, Py_TYPE (obj)->tp_name);
+        return NULL;
+    }
+
+    item = PyTuple_GET_ITEM (obj, self->index);
+    if (item == NULL) Py_RETURN_NONE;
+
+    return Py_NewRef (item);
+}
+
+static PyObject *
+resulttuple_field_new (Py_ssize_t index)
+{
+    PyGIResultTupleField *self;
+
+    self = PyObject_New (PyGIResultTupleField, &PyGIResultTupleField_Type);
+    if (self == NULL) return NULL;
+    self->index = index;
+
+    return (PyObject *)self;
+}
+
 /**
  * ResultTuple.__repr__() implementation.
  * Takes the _ResultTuple.__repr_format format string and applies the tuple
@@ -62,35 +109,6 @@ resulttuple_repr (PyObject *self)
     return repr;
 }
 
-/**
- * PyGIResultTuple_Type.tp_getattro implementation.
- * Looks up the tuple index in _ResultTuple.__tuple_indices and returns the
- * tuple item.
- */
-static PyObject *
-resulttuple_getattro (PyObject *self, PyObject *name)
-{
-    PyObject *mapping, *index, *mapping_attr, *item;
-
-    mapping_attr = PyUnicode_FromString (tuple_indices_key);
-    mapping = PyTuple_Type.tp_getattro (self, mapping_attr);
-    Py_DECREF (mapping_attr);
-    if (mapping == NULL) return NULL;
-    g_assert (PyDict_Check (mapping));
-    index = PyDict_GetItem (mapping, name);
-
-    if (index != NULL) {
-        item = PyTuple_GET_ITEM (self, PyLong_AsSsize_t (index));
-        if (item == NULL) Py_RETURN_NONE;
-        Py_INCREF (item);
-    } else {
-        item = PyTuple_Type.tp_getattro (self, name);
-    }
-    Py_DECREF (mapping);
-
-    return item;
-}
-
 /**
  * ResultTuple.__reduce__() implementation.
  * Always returns (tuple, tuple(self))
@@ -105,37 +123,6 @@ resulttuple_reduce (PyObject *self)
     return Py_BuildValue ("(O, (N))", &PyTuple_Type, tuple);
 }
 
-/**
- * Extends __dir__ with the extra attributes accessible through
- * resulttuple_getattro()
- */
-static PyObject *
-resulttuple_dir (PyObject *self)
-{
-    PyObject *mapping_attr;
-    PyObject *items = NULL;
-    PyObject *mapping = NULL;
-    PyObject *mapping_values = NULL;
-    PyObject *result = NULL;
-
-    mapping_attr = PyUnicode_FromString (tuple_indices_key);
-    mapping = PyTuple_Type.tp_getattro (self, mapping_attr);
-    Py_DECREF (mapping_attr);
-    if (mapping == NULL) goto error;
-    items = PyObject_Dir ((PyObject *)Py_TYPE (self));
-    if (items == NULL) goto error;
-    mapping_values = PyDict_Keys (mapping);
-    if (mapping_values == NULL) goto error;
-    result = PySequence_InPlaceConcat (items, mapping_values);
-
-error:
-    Py_XDECREF (items);
-    Py_XDECREF (mapping);
-    Py_XDECREF (mapping_values);
-
-    return result;
-}
-
 /**
  * resulttuple_new_type:
  * @args: one list object containing tuple item names and None
@@ -165,7 +152,6 @@ resulttuple_new_type (PyObject *self, PyObject *args)
 
 static PyMethodDef resulttuple_methods[] = {
     { "__reduce__", (PyCFunction)resulttuple_reduce, METH_NOARGS },
-    { "__dir__", (PyCFunction)resulttuple_dir, METH_NOARGS },
     { "_new_type", (PyCFunction)resulttuple_new_type,
       METH_VARARGS | METH_STATIC },
     { NULL, NULL, 0 },
@@ -181,20 +167,33 @@ static PyMethodDef resulttuple_methods[] = {
  * the same index in the tuple class. If the name is None the item/index
  * is unnamed.
  *
- * Returns: A new PyTypeObject which is a subclass of PyGIResultTuple_Type
- *    or %NULL in case of an error.
+ * Types are cached, calling this again with the same names returns the
+ * same type.
+ *
+ * Returns: A new reference to a PyTypeObject which is a subclass of
+ *    PyGIResultTuple_Type or %NULL in case of an error.
  */
 PyTypeObject *
 pygi_resulttuple_new_type (PyObject *tuple_names)
 {
     PyTypeObject *new_type;
     PyObject *class_dict, *format_string, *empty_format, *named_format,
-        *format_list, *sep, *index_dict, *slots, *paren_format, *new_type_args,
-        *paren_string;
+        *format_list, *sep, *slots, *paren_format, *new_type_args,
+        *paren_string, *key;
     Py_ssize_t len, i;
 
     g_assert (PyList_Check (tuple_names));
 
+    key = PyList_AsTuple (tuple_names);
+    if (key == NULL) return NULL;
+
+    new_type = (PyTypeObject *)PyDict_GetItemWithError (resulttuple_types, key);
+    if (new_type != NULL || PyErr_Occurred ()) {
+        Py_DECREF (key);
+        Py_XINCREF (new_type);
+        return new_type;
+    }
+
     class_dict = PyDict_New ();
 
     /* To save some memory don't use an instance dict */
@@ -203,13 +202,12 @@ pygi_resulttuple_new_type (PyObject *tuple_names)
     Py_DECREF (slots);
 
     format_list = PyList_New (0);
-    index_dict = PyDict_New ();
 
     empty_format = PyUnicode_FromString ("%r");
     named_format = PyUnicode_FromString ("%s=%%r");
     len = PyList_Size (tuple_names);
     for (i = 0; i < len; i++) {
-        PyObject *item, *named_args, *named_build, *index;
+        PyObject *item, *named_args, *named_build, *field;
         item = PyList_GET_ITEM (tuple_names, i);
         if (Py_IsNone (item)) {
             PyList_Append (format_list, empty_format);
@@ -219,9 +217,9 @@ pygi_resulttuple_new_type (PyObject *tuple_names)
             Py_DECREF (named_args);
             PyList_Append (format_list, named_build);
             Py_DECREF (named_build);
-            index = PyLong_FromSsize_t (i);
-            PyDict_SetItem (index_dict, item, index);
-            Py_DECREF (index);
+            field = resulttuple_field_new (i);
+            PyDict_SetItem (class_dict, item, field);
+            Py_DECREF (field);
         }
     }
     Py_DECREF (empty_format);
@@ -239,9 +237,6 @@ pygi_resulttuple_new_type (PyObject *tuple_names)
     PyDict_SetItemString (class_dict, repr_format_key, paren_string);
     Py_DECREF (paren_string);
 
-    PyDict_SetItemString (class_dict, tuple_indices_key, index_dict);
-    Py_DECREF (index_dict);
-
     new_type_args = Py_BuildValue ("s(O)O", "_ResultTuple",
                                    &PyGIResultTuple_Type, class_dict);
     new_type =
@@ -253,7 +248,12 @@ pygi_resulttuple_new_type (PyObject *tuple_names)
         /* disallow subclassing as that would break the free list caching
          * since we assume that all subclasses use PyTupleObject */
         new_type->tp_flags &= ~Py_TPFLAGS_BASETYPE;
+
+        if (PyDict_SetItem (resulttuple_types, key, (PyObject *)new_type)
+            < 0)
+            Py_CLEAR (new_type);
     }
+    Py_DECREF (key);
 
     return new_type;
 }
@@ -350,7 +350,6 @@ pygi_resulttuple_register_types (PyObject *module)
     PyGIResultTuple_Type.tp_base = &PyTuple_Type;
     PyGIResultTuple_Type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE;
     PyGIResultTuple_Type.tp_repr = (reprfunc)resulttuple_repr;
-    PyGIResultTuple_Type.tp_getattro = (getattrofunc)resulttuple_getattro;
     PyGIResultTuple_Type.tp_methods = resulttuple_methods;
 #ifdef PYGI_USE_FREELIST
     PyGIResultTuple_Type.tp_dealloc = (destructor)resulttuple_dealloc;
@@ -358,6 +357,14 @@ pygi_resulttuple_register_types (PyObject *module)
 
     if (PyType_Ready (&PyGIResultTuple_Type) < 0) return -1;
 
+    PyGIResultTupleField_Type.tp_flags = Py_TPFLAGS_DEFAULT;
+    PyGIResultTupleField_Type.tp_descr_get =
+        (descrgetfunc)resulttuple_field_descr_get;
+    if (PyType_Ready (&PyGIResultTupleField_Type) < 0) return -1;
+
+    resulttuple_types = PyDict_New ();
+    if (resulttuple_types == NULL) return -1;
+
     Py_INCREF (&PyGIResultTuple_Type);
     if (PyModule_AddObject (module, "ResultTuple",
                             (PyObject *)&PyGIResultTuple_Type)
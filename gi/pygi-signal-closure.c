@@ -21,6 +21,7 @@
 #include "pygi-argument.h"
 #include "pygi-boxed.h"
 #include "pygi-repository.h"
+#include "pygi-trace.h"
 #include "pygi-value.h"
 
 static GISignalInfo *
@@ -113,10 +114,14 @@ pygi_signal_closure_marshal (GClosure *closure, GValue *return_value,
     gint sig_info_highest_arg;
     GSList *list_item = NULL;
     GSList *pass_by_ref_structs = NULL;
+    gchar *trace_name = NULL;
 
     state = PyGILState_Ensure ();
 
     signal_info = ((PyGISignalClosure *)closure)->signal_info;
+    PYGI_TRACE_ENTRY (signal, trace_name,
+                      _pygi_gi_base_info_get_fullname (
+                          GI_BASE_INFO (signal_info)));
     n_sig_info_args =
         gi_callable_info_get_n_args (GI_CALLABLE_INFO (signal_info));
     g_assert_cmpint (n_sig_info_args, >=, 0);
@@ -272,6 +277,7 @@ pygi_signal_closure_marshal (GClosure *closure, GValue *return_value,
 out:
     g_slist_free (pass_by_ref_structs);
     Py_DECREF (params);
+    PYGI_TRACE_RETURN (signal, trace_name);
     PyGILState_Release (state);
 }
 
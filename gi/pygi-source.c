@@ -23,8 +23,16 @@
  * IN THE SOFTWARE.
  */
 
+#include "config.h"
+
 #include "pygi-source.h"
 
+#ifdef HAVE_EPOLL
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
 #include "pygboxed.h"
 #include "pygi-basictype.h"
 #include "pygi-boxed.h"
@@ -35,20 +43,160 @@
 typedef struct {
     GSource source;
     PyObject *obj;
+    /* prepare, check and dispatch of the class of obj, see
+     * source_resolve_methods() */
+    PyTypeObject *methods_type;
+    unsigned int methods_version;
+    PyObject *prepare;
+    PyObject *check;
+    PyObject *dispatch;
 } PyGRealSource;
 
+static PyObject *str_prepare;
+static PyObject *str_check;
+static PyObject *str_dispatch;
+
+static int
+source_intern_strings (void)
+{
+    if (str_dispatch != NULL) return 0;
+
+    str_prepare = PyUnicode_InternFromString ("prepare");
+    str_check = PyUnicode_InternFromString ("check");
+    str_dispatch = PyUnicode_InternFromString ("dispatch");
+
+    if (!str_prepare || !str_check || !str_dispatch) {
+        Py_CLEAR (str_prepare);
+        Py_CLEAR (str_check);
+        Py_CLEAR (str_dispatch);
+        return -1;
+    }
+
+    return 0;
+}
+
+static PyObject *
+source_lookup_method (PyTypeObject *type, PyObject *name)
+{
+    PyObject *mro = type->tp_mro;
+    Py_ssize_t i;
+
+    if (mro == NULL) return NULL;
+
+    /* The entry in the class dict, without binding it: only plain functions
+     * can be called with the source as first argument, None declares that
+     * the source has no check. Anything else, like a staticmethod, is
+     * called by name. */
+    for (i = 0; i < PyTuple_GET_SIZE (mro); i++) {
+        PyTypeObject *mro_type = (PyTypeObject *)PyTuple_GET_ITEM (mro, i);
+        PyObject *func;
+
+        /* NULL for static builtin types since Python 3.12 */
+        if (mro_type->tp_dict == NULL) continue;
+
+        func = PyDict_GetItem (mro_type->tp_dict, name);
+        if (func == NULL) continue;
+
+        if (PyFunction_Check (func) || Py_IsNone (func))
+            return Py_NewRef (func);
+        return NULL;
+    }
+
+    return NULL;
+}
+
+static gboolean
+source_methods_valid (PyGRealSource *pysource)
+{
+    PyTypeObject *type = Py_TYPE (pysource->obj);
+
+    if (pysource->methods_type != type) return FALSE;
+
+#ifdef PYPY_VERSION
+    /* No version tag to tell whether the class changed */
+    return FALSE;
+#else
+    /* The version tag changes with the attributes of the class */
+    if (type->tp_version_tag == 0
+        || type->tp_version_tag != pysource->methods_version)
+        return FALSE;
+
+    return TRUE;
+#endif
+}
+
+/* Looks up the methods once per class instead of by name on every main loop
+ * iteration. The ones that can't be cached are left NULL and go through
+ * PyObject_CallMethod(). Must be called with the GIL held. */
+static void
+source_resolve_methods (PyGRealSource *pysource)
+{
+    PyTypeObject *type = Py_TYPE (pysource->obj);
+
+    if (source_methods_valid (pysource)) return;
+
+    if (source_intern_strings () < 0) {
+        PyErr_Clear ();
+        return;
+    }
+
+    Py_XSETREF (pysource->prepare, source_lookup_method (type, str_prepare));
+    Py_XSETREF (pysource->check, source_lookup_method (type, str_check));
+    Py_XSETREF (pysource->dispatch,
+                source_lookup_method (type, str_dispatch));
+
+    if (Py_IsNone (pysource->prepare)) Py_CLEAR (pysource->prepare);
+    if (Py_IsNone (pysource->dispatch)) Py_CLEAR (pysource->dispatch);
+
+    Py_XSETREF (pysource->methods_type, (PyTypeObject *)Py_NewRef (type));
+#ifndef PYPY_VERSION
+    pysource->methods_version = type->tp_version_tag;
+#endif
+}
+
+/* Returns the cached method @func, or NULL if it is overridden on the
+ * instance, which can happen at any time and is checked on every call.
+ * Without an instance dict the cached method is returned right away. Python
+ * 3.13 creates the dict from the inline attribute values on the first call,
+ * after that it is only read. */
+static PyObject *
+source_get_method (PyGRealSource *pysource, PyObject *func, PyObject *name)
+{
+#ifdef PYPY_VERSION
+    /* Always called by name, see source_methods_valid() */
+    return NULL;
+#else
+    PyObject **dict_ptr;
+
+    if (func == NULL) return NULL;
+
+    dict_ptr = _PyObject_GetDictPtr (pysource->obj);
+    if (dict_ptr == NULL || *dict_ptr == NULL) return func;
+
+    if (PyDict_GetItem (*dict_ptr, name) != NULL) return NULL;
+
+    return func;
+#endif
+}
+
 static gboolean
 source_prepare (GSource *source, gint *timeout)
 {
     PyGRealSource *pysource = (PyGRealSource *)source;
-    PyObject *t;
+    PyObject *func, *t;
     gboolean ret = FALSE;
     gboolean got_err = TRUE;
     PyGILState_STATE state;
 
     state = PyGILState_Ensure ();
 
-    t = PyObject_CallMethod (pysource->obj, "prepare", NULL);
+    source_resolve_methods (pysource);
+    func = source_get_method (pysource, pysource->prepare, str_prepare);
+
+    if (func != NULL)
+        t = PyObject_Vectorcall (func, &pysource->obj, 1, NULL);
+    else
+        t = PyObject_CallMethod (pysource->obj, "prepare", NULL);
 
     if (t == NULL) {
         goto bail;
@@ -94,13 +242,27 @@ static gboolean
 source_check (GSource *source)
 {
     PyGRealSource *pysource = (PyGRealSource *)source;
-    PyObject *t;
+    PyObject *func, *t;
     gboolean ret;
     PyGILState_STATE state;
 
+    /* "check = None" in the class, resolved by the preceding prepare. Like
+     * for a GSource without check function, GLib still dispatches the
+     * source if one of its fds is ready. This is decided without the GIL,
+     * so a check set on the instance is not called in that case. */
+    if (pysource->check != NULL && Py_IsNone (pysource->check)) return FALSE;
+
     state = PyGILState_Ensure ();
 
-    t = PyObject_CallMethod (pysource->obj, "check", NULL);
+    source_resolve_methods (pysource);
+    func = source_get_method (pysource, pysource->check, str_check);
+
+    if (func != NULL && !Py_IsNone (func))
+        t = PyObject_Vectorcall (func, &pysource->obj, 1, NULL);
+    else if (func != NULL)
+        t = Py_NewRef (Py_False);
+    else
+        t = PyObject_CallMethod (pysource->obj, "check", NULL);
 
     if (t == NULL) {
         PyErr_Print ();
@@ -119,7 +281,7 @@ static gboolean
 source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
 {
     PyGRealSource *pysource = (PyGRealSource *)source;
-    PyObject *func, *args, *tuple, *t;
+    PyObject *func, *args, *tuple, *method, *t;
     gboolean ret;
     PyGILState_STATE state;
 
@@ -135,7 +297,16 @@ source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
         args = Py_None;
     }
 
-    t = PyObject_CallMethod (pysource->obj, "dispatch", "OO", func, args);
+    source_resolve_methods (pysource);
+    method = source_get_method (pysource, pysource->dispatch, str_dispatch);
+
+    if (method != NULL) {
+        PyObject *call_args[3] = { pysource->obj, func, args };
+
+        t = PyObject_Vectorcall (method, call_args, 3, NULL);
+    } else {
+        t = PyObject_CallMethod (pysource->obj, "dispatch", "OO", func, args);
+    }
 
     if (t == NULL) {
         PyErr_Print ();
@@ -150,11 +321,27 @@ source_dispatch (GSource *source, GSourceFunc callback, gpointer user_data)
     return ret;
 }
 
+static void
+source_finalize (GSource *source)
+{
+    PyGRealSource *pysource = (PyGRealSource *)source;
+    PyGILState_STATE state;
+
+    if (pysource->methods_type == NULL) return;
+
+    state = PyGILState_Ensure ();
+    Py_CLEAR (pysource->prepare);
+    Py_CLEAR (pysource->check);
+    Py_CLEAR (pysource->dispatch);
+    Py_CLEAR (pysource->methods_type);
+    PyGILState_Release (state);
+}
+
 static GSourceFuncs pyg_source_funcs = {
     source_prepare,
     source_check,
     source_dispatch,
-    NULL,
+    source_finalize,
 };
 
 static gboolean
@@ -259,3 +446,869 @@ pygi_source_new (PyObject *self, PyObject *args)
 
     return source->obj;
 }
+
+/* The GSource of GLib.IdleBatch. Callables are pushed from any thread on a
+ * lock-free stack, the first push into an empty stack makes the source
+ * ready. A dispatch then runs all of them with the GIL taken once. */
+
+typedef struct _BatchSourceItem BatchSourceItem;
+
+struct _BatchSourceItem {
+    BatchSourceItem *next;
+    PyObject *func;
+    PyObject *args;
+};
+
+typedef struct {
+    GSource source;
+    BatchSourceItem *queued;       /* pushed items, most recent first */
+    BatchSourceItem *pending;      /* items left over by the budget */
+    BatchSourceItem *pending_tail;
+    gint64 budget; /* microseconds per dispatch, 0 for no limit */
+} PyGIBatchSource;
+
+static void
+batch_source_item_free (BatchSourceItem *item)
+{
+    Py_DECREF (item->func);
+    Py_DECREF (item->args);
+    g_free (item);
+}
+
+static gboolean
+batch_source_dispatch (GSource *source, GSourceFunc callback,
+                       gpointer user_data)
+{
+    PyGIBatchSource *bsource = (PyGIBatchSource *)source;
+    BatchSourceItem *item, *queued, *items = NULL, *tail = NULL;
+    gint64 deadline = 0;
+    PyGILState_STATE state;
+
+    /* Before taking the queue, so that a push racing with us makes the
+     * source ready again */
+    g_source_set_ready_time (source, -1);
+    queued = g_atomic_pointer_exchange (&bsource->queued, NULL);
+
+    /* Restore the order in which the items were pushed */
+    while (queued != NULL) {
+        item = queued;
+        queued = item->next;
+        item->next = items;
+        items = item;
+        if (tail == NULL) tail = item;
+    }
+
+    if (items != NULL) {
+        if (bsource->pending_tail != NULL)
+            bsource->pending_tail->next = items;
+        else
+            bsource->pending = items;
+        bsource->pending_tail = tail;
+    }
+
+    state = PyGILState_Ensure ();
+
+    if (bsource->budget > 0)
+        deadline = g_get_monotonic_time () + bsource->budget;
+
+    while ((item = bsource->pending) != NULL) {
+        PyObject *ret;
+
+        bsource->pending = item->next;
+
+        ret = PyObject_Call (item->func, item->args, NULL);
+        if (ret == NULL)
+            PyErr_Print ();
+        else
+            Py_DECREF (ret);
+        batch_source_item_free (item);
+
+        if (deadline != 0 && g_get_monotonic_time () >= deadline) break;
+    }
+
+    if (bsource->pending == NULL)
+        bsource->pending_tail = NULL;
+    else
+        g_source_set_ready_time (source, 0);
+
+    PyGILState_Release (state);
+
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+batch_source_finalize (GSource *source)
+{
+    PyGIBatchSource *bsource = (PyGIBatchSource *)source;
+    BatchSourceItem *item, *next;
+    PyGILState_STATE state;
+
+    next = g_atomic_pointer_exchange (&bsource->queued, NULL);
+    if (next == NULL && bsource->pending == NULL) return;
+
+    state = PyGILState_Ensure ();
+    while ((item = next) != NULL) {
+        next = item->next;
+        batch_source_item_free (item);
+    }
+    while ((item = bsource->pending) != NULL) {
+        bsource->pending = item->next;
+        batch_source_item_free (item);
+    }
+    PyGILState_Release (state);
+}
+
+static GSourceFuncs pygi_batch_source_funcs = {
+    NULL,
+    NULL,
+    batch_source_dispatch,
+    batch_source_finalize,
+};
+
+/**
+ * pygi_batch_source_new:
+ *
+ * Creates the GSource of a GLib.IdleBatch, the argument is the time budget
+ * of a dispatch in microseconds, or 0.
+ *
+ * Returns NULL on error and sets an exception.
+ */
+PyObject *
+pygi_batch_source_new (PyObject *self, PyObject *args)
+{
+    PyGIBatchSource *bsource;
+    PyObject *py_type, *boxed;
+    gint64 budget;
+
+    if (!PyArg_ParseTuple (args, "L:batch_source_new", &budget)) return NULL;
+
+    py_type = pygi_type_import_by_name ("GLib", "Source");
+    if (!py_type) return NULL;
+
+    bsource = (PyGIBatchSource *)g_source_new (&pygi_batch_source_funcs,
+                                               sizeof (PyGIBatchSource));
+    bsource->budget = MAX (budget, 0);
+
+    boxed = pygi_boxed_new ((PyTypeObject *)py_type, bsource, TRUE, 0);
+    Py_DECREF (py_type);
+    if (!boxed) {
+        g_source_unref ((GSource *)bsource);
+        return NULL;
+    }
+
+    return boxed;
+}
+
+/**
+ * pygi_batch_source_push:
+ *
+ * Queues func(*args) on a source created by pygi_batch_source_new(), can be
+ * called from any thread.
+ */
+PyObject *
+pygi_batch_source_push (PyObject *self, PyObject *args)
+{
+    PyObject *py_source, *func, *func_args;
+    PyGIBatchSource *bsource = NULL;
+    BatchSourceItem *item, *head;
+
+    if (!PyArg_ParseTuple (args, "OOO!:batch_source_push", &py_source, &func,
+                           &PyTuple_Type, &func_args))
+        return NULL;
+
+    if (pyg_boxed_check (py_source, G_TYPE_SOURCE))
+        bsource = pyg_boxed_get (py_source, PyGIBatchSource);
+
+    if (bsource == NULL
+        || bsource->source.source_funcs != &pygi_batch_source_funcs) {
+        PyErr_SetString (PyExc_TypeError,
+                         "argument is not a GLib.IdleBatch source");
+        return NULL;
+    }
+
+    if (g_source_is_destroyed ((GSource *)bsource)) {
+        PyErr_SetString (PyExc_RuntimeError, "source was destroyed");
+        return NULL;
+    }
+
+    if (!PyCallable_Check (func)) {
+        PyErr_SetString (PyExc_TypeError, "second argument not callable");
+        return NULL;
+    }
+
+    item = g_new (BatchSourceItem, 1);
+    item->func = Py_NewRef (func);
+    item->args = Py_NewRef (func_args);
+
+    do {
+        head = g_atomic_pointer_get (&bsource->queued);
+        item->next = head;
+    } while (!g_atomic_pointer_compare_and_exchange (&bsource->queued, head,
+                                                     item));
+
+    /* Wakes up the main context if needed */
+    if (head == NULL) g_source_set_ready_time ((GSource *)bsource, 0);
+
+    Py_RETURN_NONE;
+}
+
+#ifdef G_OS_UNIX
+
+/* The GSource of gi.events.GLibEventLoop. It owns the fds registered with
+ * the selector and computes the asyncio timeout itself, so Python only gets
+ * called when there is something to dispatch.
+ *
+ * Where available the fds are registered with an epoll instance which is
+ * polled by GLib in their place, so that finding the ready fds costs as
+ * much as the number of ready fds, not the number of registered ones. fds
+ * that epoll refuses (e.g. regular files) are added to the GSource.
+ *
+ * While paused, the fds (or the epoll fd) are removed from the GSource, so
+ * that a nested iteration of the main context neither polls nor wakes up
+ * for them, not even for HUP/ERR which can't be masked. */
+
+/* selectors.EVENT_READ and selectors.EVENT_WRITE */
+#define ASYNCIO_EVENT_READ  (1 << 0)
+#define ASYNCIO_EVENT_WRITE (1 << 1)
+
+typedef struct {
+    GSource source;
+    PyObject *loop_ref; /* weak reference to the event loop */
+    GHashTable *fds;    /* fd -> AsyncioSourceFd */
+    guint n_unix_fds;   /* fds added to the GSource itself */
+    PyObject *ready;    /* list of (key, events) while dispatching */
+    gboolean dispatching;
+    gboolean paused;
+#ifdef HAVE_EPOLL
+    int epoll_fd; /* -1 if epoll is not available */
+    gpointer epoll_tag;
+    struct epoll_event *events;
+    guint n_events;
+#endif
+} PyGIAsyncioSource;
+
+typedef struct {
+    gpointer tag; /* NULL if the fd is in the epoll set or paused */
+    gboolean in_epoll;
+    GIOCondition condition;
+    PyObject *key;
+} AsyncioSourceFd;
+
+static PyObject *str_ready;
+static PyObject *str_scheduled;
+static PyObject *str_when;
+static PyObject *str_stopping;
+static PyObject *str_thread_id;
+static PyObject *str_glib_dispatch;
+
+static int
+asyncio_source_intern_strings (void)
+{
+    if (str_glib_dispatch != NULL) return 0;
+
+    str_ready = PyUnicode_InternFromString ("_ready");
+    str_scheduled = PyUnicode_InternFromString ("_scheduled");
+    str_when = PyUnicode_InternFromString ("_when");
+    str_stopping = PyUnicode_InternFromString ("_stopping");
+    str_thread_id = PyUnicode_InternFromString ("_thread_id");
+    str_glib_dispatch = PyUnicode_InternFromString ("_glib_dispatch");
+
+    if (!str_ready || !str_scheduled || !str_when || !str_stopping
+        || !str_thread_id || !str_glib_dispatch) {
+        Py_CLEAR (str_glib_dispatch);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void
+asyncio_source_fd_free (gpointer data)
+{
+    AsyncioSourceFd *entry = data;
+
+    Py_DECREF (entry->key);
+    g_free (entry);
+}
+
+static int
+asyncio_source_check_attr (PyObject *loop, PyObject *name, gboolean is_none,
+                           const char *message)
+{
+    PyObject *attr;
+    gboolean matches;
+
+    attr = PyObject_GetAttr (loop, name);
+    if (attr == NULL) return -1;
+    matches = is_none ? Py_IsNone (attr) : Py_IsTrue (attr);
+    Py_DECREF (attr);
+
+    if (matches) return PyErr_WarnEx (PyExc_RuntimeWarning, message, 1);
+
+    return 0;
+}
+
+/* Same as _GLibEventLoopMixin._get_timeout_ms(), returns -2 on error */
+static gint
+asyncio_source_get_timeout_ms (PyObject *loop)
+{
+    PyObject *attr, *handle, *when;
+    gdouble timeout;
+    int is_true;
+
+    if (asyncio_source_check_attr (
+            loop, str_thread_id, TRUE,
+            "GLibEventLoop is iterated without being marked as running. "
+            "Missing override or invalid use of existing API!")
+        < 0)
+        return -2;
+    if (asyncio_source_check_attr (
+            loop, str_stopping, FALSE,
+            "GLibEventLoop is not stopping properly. Missing override or "
+            "invalid use of existing API!")
+        < 0)
+        return -2;
+
+    attr = PyObject_GetAttr (loop, str_ready);
+    if (attr == NULL) return -2;
+    is_true = PyObject_IsTrue (attr);
+    Py_DECREF (attr);
+    if (is_true != 0) return is_true < 0 ? -2 : 0;
+
+    attr = PyObject_GetAttr (loop, str_scheduled);
+    if (attr == NULL) return -2;
+    is_true = PyObject_IsTrue (attr);
+    if (is_true <= 0) {
+        Py_DECREF (attr);
+        return is_true < 0 ? -2 : -1;
+    }
+
+    handle = PySequence_GetItem (attr, 0);
+    Py_DECREF (attr);
+    if (handle == NULL) return -2;
+    when = PyObject_GetAttr (handle, str_when);
+    Py_DECREF (handle);
+    if (when == NULL) return -2;
+    timeout = PyFloat_AsDouble (when);
+    Py_DECREF (when);
+    if (timeout == -1.0 && PyErr_Occurred ()) return -2;
+
+    /* The time is floor'ed here.
+     * Python dispatches everything ready within the next _clock_resolution. */
+    timeout = (timeout - (gdouble)g_get_monotonic_time () / G_USEC_PER_SEC)
+              * 1000;
+    if (timeout <= 0) return 0;
+    if (timeout >= G_MAXINT) return G_MAXINT;
+
+    return (gint)timeout;
+}
+
+static gint
+asyncio_source_timeout (PyGIAsyncioSource *asource)
+{
+    PyObject *loop;
+    gint timeout = -1;
+    PyGILState_STATE state;
+
+    state = PyGILState_Ensure ();
+
+    if (PyWeakref_GetRef (asource->loop_ref, &loop) > 0) {
+        timeout = asyncio_source_get_timeout_ms (loop);
+        Py_DECREF (loop);
+    }
+
+    if (timeout == -2 || PyErr_Occurred ()) {
+        PyErr_Print ();
+        timeout = -1;
+    }
+
+    PyGILState_Release (state);
+
+    return timeout;
+}
+
+static gboolean
+asyncio_source_prepare (GSource *source, gint *timeout)
+{
+    PyGIAsyncioSource *asource = (PyGIAsyncioSource *)source;
+
+    /* fds are queried by GLib, the timeout needs to be rechecked anyway */
+    *timeout = asource->paused ? -1 : asyncio_source_timeout (asource);
+
+    return FALSE;
+}
+
+static gboolean
+asyncio_source_check (GSource *source)
+{
+    PyGIAsyncioSource *asource = (PyGIAsyncioSource *)source;
+
+    /* GLib dispatches the source if any of its fds is ready, even if
+     * check returns FALSE. */
+    return !asource->paused && asyncio_source_timeout (asource) == 0;
+}
+
+static int
+asyncio_source_append_ready (PyObject *ready, AsyncioSourceFd *entry,
+                             gboolean readable, gboolean writable)
+{
+    PyObject *item;
+    long events = 0;
+    int res;
+
+    if (readable) events |= ASYNCIO_EVENT_READ;
+    if (writable) events |= ASYNCIO_EVENT_WRITE;
+    if (!events) return 0;
+
+    item = Py_BuildValue ("(Ol)", entry->key, events);
+    if (item == NULL) return -1;
+    res = PyList_Append (ready, item);
+    Py_DECREF (item);
+
+    return res;
+}
+
+#ifdef HAVE_EPOLL
+
+static gboolean
+asyncio_source_epoll_add (PyGIAsyncioSource *asource, gint fd,
+                          GIOCondition condition)
+{
+    struct epoll_event event = { 0 };
+
+    if (asource->epoll_fd < 0) return FALSE;
+
+    if (condition & G_IO_IN) event.events |= EPOLLIN;
+    if (condition & G_IO_OUT) event.events |= EPOLLOUT;
+    event.data.fd = fd;
+
+    return epoll_ctl (asource->epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+static int
+asyncio_source_collect_epoll (PyGIAsyncioSource *asource, PyObject *ready)
+{
+    guint n_epoll_fds;
+    int n_events, i;
+
+    if (asource->epoll_tag == NULL
+        || !g_source_query_unix_fd ((GSource *)asource, asource->epoll_tag))
+        return 0;
+
+    /* Wait for all the fds at once, a second epoll_wait() could report
+     * some of them twice. */
+    n_epoll_fds = g_hash_table_size (asource->fds) - asource->n_unix_fds;
+    if (n_epoll_fds == 0) return 0;
+    if (asource->n_events < n_epoll_fds) {
+        asource->events =
+            g_renew (struct epoll_event, asource->events, n_epoll_fds);
+        asource->n_events = n_epoll_fds;
+    }
+
+    do {
+        n_events = epoll_wait (asource->epoll_fd, asource->events,
+                               (int)n_epoll_fds, 0);
+    } while (n_events < 0 && errno == EINTR);
+
+    if (n_events < 0) {
+        PyErr_SetFromErrno (PyExc_OSError);
+        return -1;
+    }
+
+    for (i = 0; i < n_events; i++) {
+        struct epoll_event *event = &asource->events[i];
+        AsyncioSourceFd *entry;
+
+        entry = g_hash_table_lookup (asource->fds,
+                                     GINT_TO_POINTER (event->data.fd));
+        if (entry == NULL) continue;
+
+        /* ERR/HUP trigger both read/write */
+        if (asyncio_source_append_ready (
+                ready, entry, (event->events & ~EPOLLOUT) != 0,
+                (event->events & ~EPOLLIN) != 0)
+            < 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+#endif /* HAVE_EPOLL */
+
+static PyObject *
+asyncio_source_collect_ready (PyGIAsyncioSource *asource)
+{
+    GHashTableIter iter;
+    AsyncioSourceFd *entry;
+    PyObject *ready;
+
+    ready = PyList_New (0);
+    if (ready == NULL) return NULL;
+
+#ifdef HAVE_EPOLL
+    if (asource->epoll_fd >= 0
+        && asyncio_source_collect_epoll (asource, ready) < 0) {
+        Py_DECREF (ready);
+        return NULL;
+    }
+#endif
+
+    if (asource->n_unix_fds == 0) return ready;
+
+    g_hash_table_iter_init (&iter, asource->fds);
+    while (g_hash_table_iter_next (&iter, NULL, (gpointer *)&entry)) {
+        GIOCondition condition;
+
+        if (entry->tag == NULL) continue;
+
+        condition = g_source_query_unix_fd ((GSource *)asource, entry->tag);
+
+        /* ERR/HUP/NVAL trigger both read/write (PRI cannot happen) */
+        if (asyncio_source_append_ready (ready, entry,
+                                         (condition & ~G_IO_OUT) != 0,
+                                         (condition & ~G_IO_IN) != 0)
+            < 0) {
+            Py_DECREF (ready);
+            return NULL;
+        }
+    }
+
+    return ready;
+}
+
+static gboolean
+asyncio_source_dispatch (GSource *source, GSourceFunc callback,
+                         gpointer user_data)
+{
+    PyGIAsyncioSource *asource = (PyGIAsyncioSource *)source;
+    PyObject *loop, *ret = NULL;
+    PyGILState_STATE state;
+
+    /* Paused by a source dispatched earlier in the same iteration */
+    if (asource->paused) return G_SOURCE_CONTINUE;
+
+    state = PyGILState_Ensure ();
+
+    if (PyWeakref_GetRef (asource->loop_ref, &loop) <= 0) goto out;
+
+    asource->ready = asyncio_source_collect_ready (asource);
+    if (asource->ready != NULL) {
+        /* Now, wag the dog by its tail */
+        asource->dispatching = TRUE;
+        ret = PyObject_CallMethodNoArgs (loop, str_glib_dispatch);
+        asource->dispatching = FALSE;
+        Py_CLEAR (asource->ready);
+    }
+    Py_DECREF (loop);
+
+out:
+    if (ret == NULL && PyErr_Occurred ()) PyErr_Print ();
+    Py_XDECREF (ret);
+
+    PyGILState_Release (state);
+
+    return ret != NULL;
+}
+
+static void
+asyncio_source_finalize (GSource *source)
+{
+    PyGIAsyncioSource *asource = (PyGIAsyncioSource *)source;
+    PyGILState_STATE state;
+
+    state = PyGILState_Ensure ();
+    Py_CLEAR (asource->loop_ref);
+    Py_CLEAR (asource->ready);
+    g_clear_pointer (&asource->fds, g_hash_table_unref);
+    PyGILState_Release (state);
+
+#ifdef HAVE_EPOLL
+    if (asource->epoll_fd >= 0) close (asource->epoll_fd);
+    g_free (asource->events);
+#endif
+}
+
+static GSourceFuncs pygi_asyncio_source_funcs = {
+    asyncio_source_prepare,
+    asyncio_source_check,
+    asyncio_source_dispatch,
+    asyncio_source_finalize,
+};
+
+static PyGIAsyncioSource *
+asyncio_source_get (PyObject *py_source)
+{
+    GSource *source = NULL;
+
+    if (pyg_boxed_check (py_source, G_TYPE_SOURCE))
+        source = pyg_boxed_get (py_source, GSource);
+
+    if (source == NULL || source->source_funcs != &pygi_asyncio_source_funcs) {
+        PyErr_SetString (PyExc_TypeError,
+                         "argument is not a GLibEventLoop source");
+        return NULL;
+    }
+
+    return (PyGIAsyncioSource *)source;
+}
+
+static void
+asyncio_source_remove_fd (PyGIAsyncioSource *asource, gint fd,
+                          AsyncioSourceFd *entry)
+{
+    if (!entry->in_epoll) {
+        if (entry->tag != NULL && !g_source_is_destroyed ((GSource *)asource))
+            g_source_remove_unix_fd ((GSource *)asource, entry->tag);
+        asource->n_unix_fds--;
+    }
+#ifdef HAVE_EPOLL
+    else {
+        /* Fails if the fd got closed already, which removed it as well */
+        (void)epoll_ctl (asource->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+    }
+#endif
+
+    g_hash_table_remove (asource->fds, GINT_TO_POINTER (fd));
+}
+
+/**
+ * pygi_asyncio_source_new:
+ *
+ * Creates the GSource for a gi.events.GLibEventLoop, see
+ * gi/events.py:_Source.
+ *
+ * Returns NULL on error and sets an exception.
+ */
+PyObject *
+pygi_asyncio_source_new (PyObject *self, PyObject *loop)
+{
+    PyGIAsyncioSource *asource;
+    PyObject *py_type, *loop_ref, *boxed;
+
+    if (asyncio_source_intern_strings () < 0) return NULL;
+
+    loop_ref = PyWeakref_NewRef (loop, NULL);
+    if (loop_ref == NULL) return NULL;
+
+    py_type = pygi_type_import_by_name ("GLib", "Source");
+    if (!py_type) {
+        Py_DECREF (loop_ref);
+        return NULL;
+    }
+
+    asource = (PyGIAsyncioSource *)g_source_new (&pygi_asyncio_source_funcs,
+                                                 sizeof (PyGIAsyncioSource));
+    asource->loop_ref = loop_ref;
+    asource->fds = g_hash_table_new_full (NULL, NULL, NULL,
+                                          asyncio_source_fd_free);
+#ifdef HAVE_EPOLL
+    asource->epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+    if (asource->epoll_fd >= 0)
+        asource->epoll_tag = g_source_add_unix_fd (
+            (GSource *)asource, asource->epoll_fd, G_IO_IN);
+#endif
+
+    boxed = pygi_boxed_new ((PyTypeObject *)py_type, asource, TRUE, 0);
+    Py_DECREF (py_type);
+    if (!boxed) {
+        g_source_unref ((GSource *)asource);
+        return NULL;
+    }
+
+    return boxed;
+}
+
+/**
+ * pygi_asyncio_source_register:
+ *
+ * Adds the fd of a selectors.SelectorKey to the source, replacing any
+ * previous registration of the same fd.
+ */
+PyObject *
+pygi_asyncio_source_register (PyObject *self, PyObject *args)
+{
+    PyObject *py_source, *key, *attr;
+    PyGIAsyncioSource *asource;
+    AsyncioSourceFd *entry;
+    GIOCondition condition = 0;
+    gint fd, events;
+
+    if (!PyArg_ParseTuple (args, "OO:asyncio_source_register", &py_source,
+                           &key))
+        return NULL;
+
+    if ((asource = asyncio_source_get (py_source)) == NULL) return NULL;
+
+    if (g_source_is_destroyed ((GSource *)asource)) {
+        PyErr_SetString (PyExc_RuntimeError, "source was destroyed");
+        return NULL;
+    }
+
+    attr = PyObject_GetAttrString (key, "fd");
+    if (attr == NULL) return NULL;
+    if (!pygi_gint_from_py (attr, &fd)) {
+        Py_DECREF (attr);
+        return NULL;
+    }
+    Py_DECREF (attr);
+
+    attr = PyObject_GetAttrString (key, "events");
+    if (attr == NULL) return NULL;
+    if (!pygi_gint_from_py (attr, &events)) {
+        Py_DECREF (attr);
+        return NULL;
+    }
+    Py_DECREF (attr);
+
+    if (events & ASYNCIO_EVENT_READ) condition |= G_IO_IN;
+    if (events & ASYNCIO_EVENT_WRITE) condition |= G_IO_OUT;
+
+    entry = g_hash_table_lookup (asource->fds, GINT_TO_POINTER (fd));
+    if (entry != NULL) asyncio_source_remove_fd (asource, fd, entry);
+
+    entry = g_new0 (AsyncioSourceFd, 1);
+    entry->condition = condition;
+    entry->key = Py_NewRef (key);
+#ifdef HAVE_EPOLL
+    entry->in_epoll = asyncio_source_epoll_add (asource, fd, condition);
+#endif
+    if (!entry->in_epoll) {
+        if (!asource->paused)
+            entry->tag =
+                g_source_add_unix_fd ((GSource *)asource, fd, condition);
+        asource->n_unix_fds++;
+    }
+    g_hash_table_insert (asource->fds, GINT_TO_POINTER (fd), entry);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * pygi_asyncio_source_unregister:
+ *
+ * Removes a fd added with pygi_asyncio_source_register().
+ */
+PyObject *
+pygi_asyncio_source_unregister (PyObject *self, PyObject *args)
+{
+    PyObject *py_source;
+    PyGIAsyncioSource *asource;
+    AsyncioSourceFd *entry;
+    gint fd;
+
+    if (!PyArg_ParseTuple (args, "Oi:asyncio_source_unregister", &py_source,
+                           &fd))
+        return NULL;
+
+    if ((asource = asyncio_source_get (py_source)) == NULL) return NULL;
+
+    entry = g_hash_table_lookup (asource->fds, GINT_TO_POINTER (fd));
+    if (entry == NULL) {
+        PyErr_Format (PyExc_KeyError, "FD %d is not registered", fd);
+        return NULL;
+    }
+
+    asyncio_source_remove_fd (asource, fd, entry);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * pygi_asyncio_source_get_ready:
+ *
+ * Returns the (key, events) list of the fds which made the source dispatch,
+ * only valid once per dispatch.
+ */
+PyObject *
+pygi_asyncio_source_get_ready (PyObject *self, PyObject *py_source)
+{
+    PyGIAsyncioSource *asource;
+    PyObject *ready;
+
+    if ((asource = asyncio_source_get (py_source)) == NULL) return NULL;
+
+    if (!asource->dispatching) {
+        PyErr_SetString (
+            PyExc_RuntimeError,
+            "gi.asyncio.Selector.select only works while it is dispatching!");
+        return NULL;
+    }
+
+    ready = asource->ready;
+    asource->ready = NULL;
+
+    return ready != NULL ? ready : PyList_New (0);
+}
+
+/**
+ * pygi_asyncio_source_set_paused:
+ *
+ * Stops polling the fds and computing the timeout of the source while
+ * paused, without having to remove it from its main context. The fds are
+ * removed from the GSource until it is resumed.
+ */
+PyObject *
+pygi_asyncio_source_set_paused (PyObject *self, PyObject *args)
+{
+    PyObject *py_source;
+    PyGIAsyncioSource *asource;
+    GSource *source;
+    GHashTableIter iter;
+    gpointer fd;
+    AsyncioSourceFd *entry;
+    int paused;
+
+    if (!PyArg_ParseTuple (args, "Op:asyncio_source_set_paused", &py_source,
+                           &paused))
+        return NULL;
+
+    if ((asource = asyncio_source_get (py_source)) == NULL) return NULL;
+
+    if (asource->paused == paused) Py_RETURN_NONE;
+    asource->paused = paused;
+
+    source = (GSource *)asource;
+    if (g_source_is_destroyed (source)) Py_RETURN_NONE;
+
+#ifdef HAVE_EPOLL
+    if (asource->epoll_fd >= 0) {
+        if (paused) {
+            g_source_remove_unix_fd (source, asource->epoll_tag);
+            asource->epoll_tag = NULL;
+        } else {
+            asource->epoll_tag =
+                g_source_add_unix_fd (source, asource->epoll_fd, G_IO_IN);
+        }
+    }
+#endif
+
+    if (asource->n_unix_fds == 0) Py_RETURN_NONE;
+
+    g_hash_table_iter_init (&iter, asource->fds);
+    while (g_hash_table_iter_next (&iter, &fd, (gpointer *)&entry)) {
+        if (entry->in_epoll) continue;
+
+        if (paused) {
+            g_source_remove_unix_fd (source, entry->tag);
+            entry->tag = NULL;
+        } else {
+            entry->tag = g_source_add_unix_fd (source, GPOINTER_TO_INT (fd),
+                                               entry->condition);
+        }
+    }
+
+    Py_RETURN_NONE;
+}
+
+PyObject *
+pygi_asyncio_source_is_dispatching (PyObject *self, PyObject *py_source)
+{
+    PyGIAsyncioSource *asource;
+
+    if ((asource = asyncio_source_get (py_source)) == NULL) return NULL;
+
+    return PyBool_FromLong (asource->dispatching);
+}
+
+#endif /* G_OS_UNIX */
@@ -30,5 +30,17 @@ G_BEGIN_DECLS
 
 PyObject *pygi_source_new (PyObject *self, PyObject *args);
 PyObject *pygi_source_set_callback (PyObject *self, PyObject *args);
+PyObject *pygi_batch_source_new (PyObject *self, PyObject *args);
+PyObject *pygi_batch_source_push (PyObject *self, PyObject *args);
+
+#ifdef G_OS_UNIX
+PyObject *pygi_asyncio_source_new (PyObject *self, PyObject *loop);
+PyObject *pygi_asyncio_source_register (PyObject *self, PyObject *args);
+PyObject *pygi_asyncio_source_unregister (PyObject *self, PyObject *args);
+PyObject *pygi_asyncio_source_get_ready (PyObject *self, PyObject *py_source);
+PyObject *pygi_asyncio_source_set_paused (PyObject *self, PyObject *args);
+PyObject *pygi_asyncio_source_is_dispatching (PyObject *self,
+                                              PyObject *py_source);
+#endif
 
 G_END_DECLS
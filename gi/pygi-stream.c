@@ -0,0 +1,602 @@
+/* -*- Mode: C; c-basic-offset: 4 -*-
+ * vim: tabstop=4 shiftwidth=4 expandtab
+ *
+ *   pygi-stream.c: helpers for Gio streams
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pygi-stream.h"
+
+#include <girepository/girepository.h>
+
+#include "pygboxed.h"
+#include "pygi-boxed.h"
+#include "pygi-error.h"
+#include "pygi-repository.h"
+#include "pygi-type.h"
+#include "pygobject-object.h"
+
+/* _gi doesn't link against Gio, the few functions used here and in
+ * pygi-dbus.c are looked up through the typelib on first use. */
+
+typedef gssize (*InputStreamReadFunc) (gpointer stream, void *buffer,
+                                       gsize count, gpointer cancellable,
+                                       GError **error);
+typedef gboolean (*OutputStreamWriteAllFunc) (gpointer stream,
+                                              const void *buffer, gsize count,
+                                              gsize *bytes_written,
+                                              gpointer cancellable,
+                                              GError **error);
+
+typedef gpointer (*CancellableNewFunc) (void);
+typedef void (*CancellableCancelFunc) (gpointer cancellable);
+typedef gboolean (*CancellableIsCancelledFunc) (gpointer cancellable);
+
+static InputStreamReadFunc input_stream_read;
+static OutputStreamWriteAllFunc output_stream_write_all;
+static CancellableNewFunc cancellable_new;
+static CancellableCancelFunc cancellable_cancel;
+static CancellableIsCancelledFunc cancellable_is_cancelled;
+static GType input_stream_type;
+static GType output_stream_type;
+static GType cancellable_type;
+
+gpointer
+pygi_gio_lookup_method (const char *type_name, const char *method_name,
+                        GType *type_out)
+{
+    GIBaseInfo *info;
+    GIFunctionInfo *method_info = NULL;
+    GIFunctionInvoker invoker;
+    gpointer address = NULL;
+    GError *error = NULL;
+
+    info = gi_repository_find_by_name (pygi_repository_get_default (), "Gio",
+                                       type_name);
+    if (info != NULL && GI_IS_OBJECT_INFO (info))
+        method_info =
+            gi_object_info_find_method ((GIObjectInfo *)info, method_name);
+
+    if (method_info == NULL) {
+        PyErr_Format (PyExc_RuntimeError, "could not find Gio.%s.%s",
+                      type_name, method_name);
+    } else if (gi_function_info_prep_invoker (method_info, &invoker, &error)) {
+        address = invoker.native_address;
+        *type_out =
+            gi_registered_type_info_get_g_type ((GIRegisteredTypeInfo *)info);
+        gi_function_invoker_clear (&invoker);
+    } else {
+        pygi_error_check (&error);
+    }
+
+    if (method_info != NULL) gi_base_info_unref (method_info);
+    if (info != NULL) gi_base_info_unref (info);
+
+    return address;
+}
+
+static gboolean
+gio_functions_init (void)
+{
+    if (input_stream_read != NULL) return TRUE;
+
+    output_stream_write_all = pygi_gio_lookup_method (
+        "OutputStream", "write_all", &output_stream_type);
+    if (output_stream_write_all == NULL) return FALSE;
+
+    cancellable_new =
+        pygi_gio_lookup_method ("Cancellable", "new", &cancellable_type);
+    cancellable_cancel =
+        pygi_gio_lookup_method ("Cancellable", "cancel", &cancellable_type);
+    cancellable_is_cancelled = pygi_gio_lookup_method (
+        "Cancellable", "is_cancelled", &cancellable_type);
+    if (cancellable_new == NULL || cancellable_cancel == NULL
+        || cancellable_is_cancelled == NULL)
+        return FALSE;
+
+    /* Last, it marks the functions as initialized */
+    input_stream_read =
+        pygi_gio_lookup_method ("InputStream", "read", &input_stream_type);
+
+    return input_stream_read != NULL;
+}
+
+gboolean
+pygi_gio_object_from_py (PyObject *py_obj, GType type,
+                         const char *type_name, gboolean allow_none,
+                         gpointer *out)
+{
+    if (allow_none && Py_IsNone (py_obj)) {
+        *out = NULL;
+        return TRUE;
+    }
+
+    if (type != G_TYPE_INVALID && pygobject_check (py_obj, &PyGObject_Type)
+        && G_TYPE_CHECK_INSTANCE_TYPE (pygobject_get (py_obj), type)) {
+        *out = pygobject_get (py_obj);
+        return TRUE;
+    }
+
+    PyErr_Format (PyExc_TypeError, "expected %s%s, not %s", type_name,
+                  allow_none ? " or None" : "", Py_TYPE (py_obj)->tp_name);
+    return FALSE;
+}
+
+PyObject *
+pygi_input_stream_readinto (PyObject *self, PyObject *args)
+{
+    PyObject *py_stream, *py_buffer, *py_cancellable = Py_None;
+    gpointer stream, cancellable;
+    Py_buffer view;
+    gssize n_read;
+    /* Cleared by pygi_error_check(). */
+    GError *error = NULL;
+
+    if (!PyArg_ParseTuple (args, "OO|O:input_stream_readinto", &py_stream,
+                           &py_buffer, &py_cancellable)) {
+        return NULL;
+    }
+
+    if (!gio_functions_init ()
+        || !pygi_gio_object_from_py (py_stream, input_stream_type,
+                                     "Gio.InputStream", FALSE, &stream)
+        || !pygi_gio_object_from_py (py_cancellable,
+                                     g_type_from_name ("GCancellable"),
+                                     "Gio.Cancellable", TRUE, &cancellable))
+        return NULL;
+
+    if (PyObject_GetBuffer (py_buffer, &view, PyBUF_WRITABLE) == -1)
+        return NULL;
+
+    g_object_ref (stream);
+    if (cancellable != NULL) g_object_ref (cancellable);
+
+    Py_BEGIN_ALLOW_THREADS;
+    n_read = input_stream_read (stream, view.buf, (gsize)view.len, cancellable,
+                                &error);
+    Py_END_ALLOW_THREADS;
+
+    if (cancellable != NULL) g_object_unref (cancellable);
+    g_object_unref (stream);
+    PyBuffer_Release (&view);
+
+    if (pygi_error_check (&error)) return NULL;
+
+    return PyLong_FromSsize_t (n_read);
+}
+
+/* A stream pump moves data out of a GInputStream in a worker thread, either
+ * into a GOutputStream or to a Python callback. The GSource is woken up by
+ * the worker and hands all chunks read so far to the callback at once.
+ *
+ * The callback is called as callback(chunks, error, total) with a list of
+ * GLib.Bytes, and a last time with chunks set to None once the input ended
+ * or failed. Python acknowledges consumed chunks with stream_pump_ack(), the
+ * worker stops reading while @depth chunks are unacknowledged.
+ *
+ * The worker always uses a cancellable owned by the pump, which is cancelled
+ * by stream_pump_stop() and when the caller's cancellable is cancelled, so
+ * that stopping doesn't leave the thread blocked in a read or write. */
+
+typedef struct {
+    GSource source;
+    GObject *input;
+    GObject *output; /* NULL when passing chunks to Python */
+    GObject *cancellable; /* owned by the pump */
+    GObject *caller_cancellable;
+    gulong caller_handler_id;
+    gsize chunk_size;
+    guint depth;
+    PyObject *callback;
+
+    GMutex lock;
+    GCond cond;
+    GQueue chunks;  /* GBytes not yet dispatched */
+    guint in_flight; /* chunks not yet acknowledged */
+    guint64 total;
+    gboolean stopping;
+    gboolean finished;
+    GError *error;
+} PyGIStreamPump;
+
+static gpointer
+stream_pump_thread (gpointer data)
+{
+    PyGIStreamPump *pump = data;
+    guint8 *buffer = NULL;
+    GError *error = NULL;
+
+    for (;;) {
+        gboolean stopping, was_empty;
+        gssize n_read;
+
+        g_mutex_lock (&pump->lock);
+        while (!pump->stopping && pump->in_flight >= pump->depth)
+            g_cond_wait (&pump->cond, &pump->lock);
+        stopping = pump->stopping;
+        g_mutex_unlock (&pump->lock);
+
+        if (stopping) break;
+
+        if (buffer == NULL) buffer = g_malloc (pump->chunk_size);
+
+        n_read = input_stream_read (pump->input, buffer, pump->chunk_size,
+                                    pump->cancellable, &error);
+        if (n_read <= 0) break;
+
+        if (pump->output != NULL) {
+            if (!output_stream_write_all (pump->output, buffer, (gsize)n_read,
+                                          NULL, pump->cancellable, &error))
+                break;
+
+            g_mutex_lock (&pump->lock);
+            pump->total += (guint64)n_read;
+            g_mutex_unlock (&pump->lock);
+            continue;
+        }
+
+        if ((gsize)n_read < pump->chunk_size)
+            buffer = g_realloc (buffer, (gsize)n_read);
+
+        g_mutex_lock (&pump->lock);
+        was_empty = g_queue_is_empty (&pump->chunks);
+        g_queue_push_tail (&pump->chunks,
+                           g_bytes_new_take (buffer, (gsize)n_read));
+        pump->in_flight++;
+        pump->total += (guint64)n_read;
+        g_mutex_unlock (&pump->lock);
+
+        buffer = NULL;
+
+        if (was_empty) g_source_set_ready_time ((GSource *)pump, 0);
+    }
+
+    g_free (buffer);
+
+    g_mutex_lock (&pump->lock);
+    pump->finished = TRUE;
+    pump->error = error;
+    g_mutex_unlock (&pump->lock);
+
+    g_source_set_ready_time ((GSource *)pump, 0);
+    g_source_unref ((GSource *)pump);
+
+    return NULL;
+}
+
+static PyObject *
+stream_pump_chunks_to_py (GQueue *chunks)
+{
+    PyObject *py_type, *py_chunks;
+    GBytes *chunk;
+    Py_ssize_t i = 0;
+
+    py_type = pygi_type_import_by_name ("GLib", "Bytes");
+    if (py_type == NULL) return NULL;
+
+    py_chunks = PyList_New ((Py_ssize_t)chunks->length);
+    if (py_chunks == NULL) goto out;
+
+    while ((chunk = g_queue_pop_head (chunks)) != NULL) {
+        PyObject *py_chunk =
+            pygi_boxed_new ((PyTypeObject *)py_type, chunk, TRUE, 0);
+
+        if (py_chunk == NULL) {
+            g_bytes_unref (chunk);
+            Py_CLEAR (py_chunks);
+            goto out;
+        }
+        PyList_SET_ITEM (py_chunks, i++, py_chunk);
+    }
+
+out:
+    g_queue_clear_full (chunks, (GDestroyNotify)g_bytes_unref);
+    Py_DECREF (py_type);
+    return py_chunks;
+}
+
+static gboolean
+stream_pump_call (PyGIStreamPump *pump, PyObject *py_chunks,
+                  PyObject *py_error, guint64 total)
+{
+    PyObject *callback, *ret;
+
+    if (pump->callback == NULL) return FALSE;
+
+    /* The callback may stop the pump, which drops its reference */
+    callback = Py_NewRef (pump->callback);
+    ret = PyObject_CallFunction (callback, "OOK", py_chunks, py_error,
+                                 (unsigned long long)total);
+    Py_DECREF (callback);
+
+    if (ret == NULL) {
+        PyErr_Print ();
+        return FALSE;
+    }
+
+    Py_DECREF (ret);
+    return TRUE;
+}
+
+static gboolean
+stream_pump_dispatch (GSource *source, GSourceFunc callback,
+                      gpointer user_data)
+{
+    PyGIStreamPump *pump = (PyGIStreamPump *)source;
+    GQueue chunks = G_QUEUE_INIT;
+    GError *error = NULL;
+    gboolean finished, keep = TRUE;
+    guint64 total;
+    PyGILState_STATE state;
+
+    /* Before taking the chunks, so that a push racing with us makes the
+     * source ready again */
+    g_source_set_ready_time (source, -1);
+
+    g_mutex_lock (&pump->lock);
+    chunks = pump->chunks;
+    g_queue_init (&pump->chunks);
+    finished = pump->finished;
+    error = g_steal_pointer (&pump->error);
+    total = pump->total;
+    g_mutex_unlock (&pump->lock);
+
+    if (g_queue_is_empty (&chunks) && !finished) return G_SOURCE_CONTINUE;
+
+    state = PyGILState_Ensure ();
+
+    if (!g_queue_is_empty (&chunks)) {
+        PyObject *py_chunks = stream_pump_chunks_to_py (&chunks);
+
+        if (py_chunks == NULL) {
+            PyErr_Print ();
+            keep = FALSE;
+        } else {
+            keep = stream_pump_call (pump, py_chunks, Py_None, total);
+            Py_DECREF (py_chunks);
+        }
+    }
+
+    if (finished && keep) {
+        PyObject *py_error = pygi_error_marshal_to_py (&error);
+
+        if (py_error == NULL) {
+            PyErr_Print ();
+        } else {
+            stream_pump_call (pump, Py_None, py_error, total);
+            Py_DECREF (py_error);
+        }
+    }
+
+    if (finished || !keep) {
+        g_mutex_lock (&pump->lock);
+        pump->stopping = TRUE;
+        g_cond_signal (&pump->cond);
+        g_mutex_unlock (&pump->lock);
+
+        Py_CLEAR (pump->callback);
+    }
+
+    PyGILState_Release (state);
+
+    g_clear_error (&error);
+
+    return (finished || !keep) ? G_SOURCE_REMOVE : G_SOURCE_CONTINUE;
+}
+
+static void
+stream_pump_finalize (GSource *source)
+{
+    PyGIStreamPump *pump = (PyGIStreamPump *)source;
+
+    g_queue_clear_full (&pump->chunks, (GDestroyNotify)g_bytes_unref);
+    g_clear_error (&pump->error);
+    g_clear_object (&pump->input);
+    g_clear_object (&pump->output);
+    if (pump->caller_handler_id != 0)
+        g_signal_handler_disconnect (pump->caller_cancellable,
+                                     pump->caller_handler_id);
+    g_clear_object (&pump->caller_cancellable);
+    g_clear_object (&pump->cancellable);
+    g_mutex_clear (&pump->lock);
+    g_cond_clear (&pump->cond);
+
+    if (pump->callback != NULL) {
+        PyGILState_STATE state = PyGILState_Ensure ();
+        Py_CLEAR (pump->callback);
+        PyGILState_Release (state);
+    }
+}
+
+static void
+stream_pump_caller_cancelled (GObject *caller_cancellable, gpointer data)
+{
+    cancellable_cancel (data);
+}
+
+static GSourceFuncs stream_pump_funcs = {
+    NULL,
+    NULL,
+    stream_pump_dispatch,
+    stream_pump_finalize,
+};
+
+static PyGIStreamPump *
+stream_pump_from_py (PyObject *py_source)
+{
+    PyGIStreamPump *pump = NULL;
+
+    if (pyg_boxed_check (py_source, G_TYPE_SOURCE))
+        pump = pyg_boxed_get (py_source, PyGIStreamPump);
+
+    if (pump == NULL || pump->source.source_funcs != &stream_pump_funcs) {
+        PyErr_SetString (PyExc_TypeError, "argument is not a stream pump");
+        return NULL;
+    }
+
+    return pump;
+}
+
+/**
+ * pygi_stream_pump_new:
+ *
+ * stream_pump_new(input, output, chunk_size, depth, cancellable, callback)
+ * starts pumping @input into @output, or to @callback if @output is None.
+ * The returned GLib.Source is attached to the thread default main context.
+ */
+PyObject *
+pygi_stream_pump_new (PyObject *self, PyObject *args)
+{
+    PyObject *py_input, *py_output, *py_cancellable, *py_callback;
+    PyObject *py_type, *py_source;
+    gpointer input, output, cancellable;
+    Py_ssize_t chunk_size;
+    unsigned int depth;
+    PyGIStreamPump *pump;
+    GMainContext *context;
+    GThread *thread;
+    GError *error = NULL;
+
+    if (!PyArg_ParseTuple (args, "OOnIOO:stream_pump_new", &py_input,
+                           &py_output, &chunk_size, &depth, &py_cancellable,
+                           &py_callback))
+        return NULL;
+
+    if (!gio_functions_init ()
+        || !pygi_gio_object_from_py (py_input, input_stream_type,
+                                     "Gio.InputStream", FALSE, &input)
+        || !pygi_gio_object_from_py (py_output, output_stream_type,
+                                     "Gio.OutputStream", TRUE, &output)
+        || !pygi_gio_object_from_py (py_cancellable,
+                                     g_type_from_name ("GCancellable"),
+                                     "Gio.Cancellable", TRUE, &cancellable))
+        return NULL;
+
+    if (chunk_size <= 0 || depth == 0) {
+        PyErr_SetString (PyExc_ValueError,
+                         "chunk size and depth must be positive");
+        return NULL;
+    }
+
+    if (!PyCallable_Check (py_callback)) {
+        PyErr_SetString (PyExc_TypeError, "callback is not callable");
+        return NULL;
+    }
+
+    py_type = pygi_type_import_by_name ("GLib", "Source");
+    if (py_type == NULL) return NULL;
+
+    pump = (PyGIStreamPump *)g_source_new (&stream_pump_funcs,
+                                           sizeof (PyGIStreamPump));
+    pump->input = g_object_ref (input);
+    pump->output = output ? g_object_ref (output) : NULL;
+    pump->cancellable = cancellable_new ();
+    if (cancellable != NULL) {
+        /* Chained like g_cancellable_connect() would */
+        pump->caller_cancellable = g_object_ref (cancellable);
+        pump->caller_handler_id = g_signal_connect_data (
+            cancellable, "cancelled",
+            G_CALLBACK (stream_pump_caller_cancelled),
+            g_object_ref (pump->cancellable), (GClosureNotify)g_object_unref,
+            0);
+        if (cancellable_is_cancelled (cancellable))
+            cancellable_cancel (pump->cancellable);
+    }
+    pump->chunk_size = (gsize)chunk_size;
+    pump->depth = depth;
+    pump->callback = Py_NewRef (py_callback);
+    g_mutex_init (&pump->lock);
+    g_cond_init (&pump->cond);
+    g_queue_init (&pump->chunks);
+    g_source_set_name ((GSource *)pump, "PyGObject stream pump");
+
+    py_source = pygi_boxed_new ((PyTypeObject *)py_type, pump, TRUE, 0);
+    Py_DECREF (py_type);
+    if (py_source == NULL) {
+        g_source_unref ((GSource *)pump);
+        return NULL;
+    }
+
+    context = g_main_context_ref_thread_default ();
+    g_source_attach ((GSource *)pump, context);
+    g_main_context_unref (context);
+
+    thread = g_thread_try_new ("pygi-stream-pump", stream_pump_thread,
+                               g_source_ref ((GSource *)pump), &error);
+    if (thread == NULL) {
+        g_source_destroy ((GSource *)pump);
+        g_source_unref ((GSource *)pump);
+        Py_DECREF (py_source);
+        pygi_error_check (&error);
+        return NULL;
+    }
+    g_thread_unref (thread);
+
+    return py_source;
+}
+
+/**
+ * pygi_stream_pump_ack:
+ *
+ * stream_pump_ack(source, n_chunks) tells the worker that @n_chunks chunks
+ * passed to the callback were consumed.
+ */
+PyObject *
+pygi_stream_pump_ack (PyObject *self, PyObject *args)
+{
+    PyObject *py_source;
+    PyGIStreamPump *pump;
+    unsigned int n_chunks;
+
+    if (!PyArg_ParseTuple (args, "OI:stream_pump_ack", &py_source, &n_chunks))
+        return NULL;
+
+    pump = stream_pump_from_py (py_source);
+    if (pump == NULL) return NULL;
+
+    g_mutex_lock (&pump->lock);
+    pump->in_flight -= MIN (n_chunks, pump->in_flight);
+    g_cond_signal (&pump->cond);
+    g_mutex_unlock (&pump->lock);
+
+    Py_RETURN_NONE;
+}
+
+/**
+ * pygi_stream_pump_stop:
+ *
+ * Stops the worker, cancelling the read or write in progress, and destroys
+ * the source, the callback isn't called anymore. The worker thread is
+ * detached and exits once the cancelled operation returned.
+ */
+PyObject *
+pygi_stream_pump_stop (PyObject *self, PyObject *py_source)
+{
+    PyGIStreamPump *pump = stream_pump_from_py (py_source);
+
+    if (pump == NULL) return NULL;
+
+    g_mutex_lock (&pump->lock);
+    pump->stopping = TRUE;
+    g_cond_signal (&pump->cond);
+    g_mutex_unlock (&pump->lock);
+
+    cancellable_cancel (pump->cancellable);
+
+    g_source_destroy ((GSource *)pump);
+    Py_CLEAR (pump->callback);
+
+    Py_RETURN_NONE;
+}
@@ -0,0 +1,38 @@
+/* -*- Mode: C; c-basic-offset: 4 -*-
+ * vim: tabstop=4 shiftwidth=4 expandtab
+ *
+ *   pygi-stream.h: helpers for Gio streams
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <glib.h>
+#include <pythoncapi_compat.h>
+
+G_BEGIN_DECLS
+
+gpointer pygi_gio_lookup_method (const char *type_name,
+                                 const char *method_name, GType *type_out);
+gboolean pygi_gio_object_from_py (PyObject *py_obj, GType type,
+                                  const char *type_name, gboolean allow_none,
+                                  gpointer *out);
+
+PyObject *pygi_input_stream_readinto (PyObject *self, PyObject *args);
+PyObject *pygi_stream_pump_new (PyObject *self, PyObject *args);
+PyObject *pygi_stream_pump_ack (PyObject *self, PyObject *args);
+PyObject *pygi_stream_pump_stop (PyObject *self, PyObject *py_source);
+
+G_END_DECLS
@@ -216,6 +216,191 @@ struct_repr (PyGIStruct *self)
     return repr;
 }
 
+/* Returns the memoryview format and the size of a scalar field type, or
+ * %NULL if the field type can't be exposed as a column. */
+static const char *
+column_format (GITypeTag type_tag, gsize *size)
+{
+    switch (type_tag) {
+    case GI_TYPE_TAG_BOOLEAN:
+        *size = sizeof (gboolean);
+        return "i";
+    case GI_TYPE_TAG_INT8:
+        *size = sizeof (gint8);
+        return "b";
+    case GI_TYPE_TAG_UINT8:
+        *size = sizeof (guint8);
+        return "B";
+    case GI_TYPE_TAG_INT16:
+        *size = sizeof (gint16);
+        return "h";
+    case GI_TYPE_TAG_UINT16:
+        *size = sizeof (guint16);
+        return "H";
+    case GI_TYPE_TAG_INT32:
+        *size = sizeof (gint32);
+        return "i";
+    case GI_TYPE_TAG_UINT32:
+    case GI_TYPE_TAG_UNICHAR:
+        *size = sizeof (guint32);
+        return "I";
+    case GI_TYPE_TAG_INT64:
+        *size = sizeof (gint64);
+        return "q";
+    case GI_TYPE_TAG_UINT64:
+        *size = sizeof (guint64);
+        return "Q";
+    case GI_TYPE_TAG_FLOAT:
+        *size = sizeof (gfloat);
+        return "f";
+    case GI_TYPE_TAG_DOUBLE:
+        *size = sizeof (gdouble);
+        return "d";
+    case GI_TYPE_TAG_GTYPE:
+        *size = sizeof (GType);
+        return "N";
+    case GI_TYPE_TAG_VOID:
+    case GI_TYPE_TAG_UTF8:
+    case GI_TYPE_TAG_FILENAME:
+    case GI_TYPE_TAG_ARRAY:
+    case GI_TYPE_TAG_INTERFACE:
+    case GI_TYPE_TAG_GLIST:
+    case GI_TYPE_TAG_GSLIST:
+    case GI_TYPE_TAG_GHASH:
+    case GI_TYPE_TAG_ERROR:
+        return NULL;
+    default:
+        g_assert_not_reached ();
+        return NULL;
+    }
+}
+
+static gboolean
+struct_array_add_column (PyObject *columns, const gchar *name,
+                         GITypeTag type_tag, gsize offset,
+                         const guint8 *data, gsize n_items, gsize item_size)
+{
+    const char *format;
+    gsize size, i;
+    PyObject *bytes, *view, *column;
+    char *out;
+    int ret;
+
+    format = column_format (type_tag, &size);
+    if (format == NULL) return TRUE;
+
+    bytes = PyBytes_FromStringAndSize (NULL, (Py_ssize_t)(n_items * size));
+    if (bytes == NULL) return FALSE;
+
+    out = PyBytes_AS_STRING (bytes);
+    for (i = 0; i < n_items; i++)
+        memcpy (out + i * size, data + i * item_size + offset, size);
+
+    view = PyMemoryView_FromObject (bytes);
+    Py_DECREF (bytes);
+    if (view == NULL) return FALSE;
+
+    column = PyObject_CallMethod (view, "cast", "s", format);
+    Py_DECREF (view);
+    if (column == NULL) return FALSE;
+
+    ret = PyDict_SetItemString (columns, name, column);
+    Py_DECREF (column);
+
+    return ret == 0;
+}
+
+static gboolean
+struct_array_add_columns (PyObject *columns, GIStructInfo *info,
+                          const gchar *prefix, gsize base_offset,
+                          const guint8 *data, gsize n_items, gsize item_size)
+{
+    guint i, n_fields;
+    gboolean ok = TRUE;
+
+    n_fields = gi_struct_info_get_n_fields (info);
+
+    for (i = 0; ok && i < n_fields; i++) {
+        GIFieldInfo *field_info;
+        GITypeInfo *type_info;
+        GITypeTag type_tag;
+        gsize offset;
+        gchar *name;
+
+        field_info = gi_struct_info_get_field (info, i);
+        type_info = gi_field_info_get_type_info (field_info);
+        type_tag = gi_type_info_get_tag (type_info);
+        offset = base_offset + gi_field_info_get_offset (field_info);
+
+        if (prefix)
+            name = g_strconcat (
+                prefix, ".", gi_base_info_get_name ((GIBaseInfo *)field_info),
+                NULL);
+        else
+            name = g_strdup (gi_base_info_get_name ((GIBaseInfo *)field_info));
+
+        /* Pointers can't be columns, bitfields are skipped as well. */
+        if (gi_type_info_is_pointer (type_info)
+            || gi_field_info_get_size (field_info) != 0) {
+            type_tag = GI_TYPE_TAG_VOID;
+        } else if (type_tag == GI_TYPE_TAG_INTERFACE) {
+            GIBaseInfo *interface_info;
+
+            interface_info = gi_type_info_get_interface (type_info);
+            type_tag = GI_TYPE_TAG_VOID;
+            if (GI_IS_STRUCT_INFO (interface_info))
+                ok = struct_array_add_columns (
+                    columns, (GIStructInfo *)interface_info, name, offset,
+                    data, n_items, item_size);
+            else if (GI_IS_ENUM_INFO (interface_info))
+                type_tag = gi_enum_info_get_storage_type (
+                    (GIEnumInfo *)interface_info);
+
+            gi_base_info_unref (interface_info);
+        }
+
+        if (ok && type_tag != GI_TYPE_TAG_VOID)
+            ok = struct_array_add_column (columns, name, type_tag, offset,
+                                          data, n_items, item_size);
+
+        g_free (name);
+        gi_base_info_unref ((GIBaseInfo *)type_info);
+        gi_base_info_unref ((GIBaseInfo *)field_info);
+    }
+
+    return ok;
+}
+
+/**
+ * pygi_struct_array_to_columns:
+ * @info: a simple struct type, see pygi_gi_struct_info_is_simple()
+ * @data: (array length=n_items): the structs
+ * @n_items: the number of structs in @data
+ * @item_size: the distance between two structs in @data
+ *
+ * Converts an array of structs to a dict mapping field names to memoryviews
+ * of their values, one per field. Fields of nested structs are named
+ * "outer.inner". Fields which are not numbers, enums or flags are left
+ * out.
+ *
+ * Returns: a new dict, or %NULL with an exception set.
+ */
+PyObject *
+pygi_struct_array_to_columns (GIStructInfo *info, gconstpointer data,
+                              gsize n_items, gsize item_size)
+{
+    PyObject *columns;
+
+    columns = PyDict_New ();
+    if (columns == NULL) return NULL;
+
+    if (!struct_array_add_columns (columns, info, NULL, 0, data, n_items,
+                                   item_size))
+        Py_CLEAR (columns);
+
+    return columns;
+}
+
 /**
  * Returns 0 on success, or -1 and sets an exception.
  */
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <girepository/girepository.h>
 #include <pythoncapi_compat.h>
 
 #include "pygobject-types.h"
@@ -38,6 +39,9 @@ PyObject *pygi_struct_new (PyTypeObject *type, gpointer pointer,
 PyObject *pygi_struct_new_from_g_type (GType g_type, gpointer pointer,
                                        gboolean free_on_dealloc);
 
+PyObject *pygi_struct_array_to_columns (GIStructInfo *info, gconstpointer data,
+                                        gsize n_items, gsize item_size);
+
 int pygi_struct_register_types (PyObject *m);
 
 G_END_DECLS
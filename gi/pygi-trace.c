@@ -0,0 +1,35 @@
+/* -*- Mode: C; c-basic-offset: 4 -*-
+ * vim: tabstop=4 shiftwidth=4 expandtab
+ *
+ *   pygi-trace.c: static tracepoint semaphores
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pygi-trace.h"
+
+/* Tracers (perf, systemtap, bpftrace) increment these when attaching to a
+ * probe, see PYGI_TRACE_ENABLED(). */
+#define PYGI_TRACE_DEFINE_PROBE(probe)                                        \
+    unsigned short PYGI_TRACE_SEMAPHORE (probe)                               \
+        __attribute__ ((section (".probes"))) = 0
+
+PYGI_TRACE_DEFINE_PROBE (invoke__entry);
+PYGI_TRACE_DEFINE_PROBE (invoke__return);
+PYGI_TRACE_DEFINE_PROBE (closure__entry);
+PYGI_TRACE_DEFINE_PROBE (closure__return);
+PYGI_TRACE_DEFINE_PROBE (signal__entry);
+PYGI_TRACE_DEFINE_PROBE (signal__return);
+PYGI_TRACE_DEFINE_PROBE (async__finish__entry);
+PYGI_TRACE_DEFINE_PROBE (async__finish__return);
@@ -0,0 +1,98 @@
+/* -*- Mode: C; c-basic-offset: 4 -*-
+ * vim: tabstop=4 shiftwidth=4 expandtab
+ *
+ *   pygi-trace.h: static tracepoints
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "config.h"
+
+#include <glib.h>
+
+#ifdef HAVE_DTRACE
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+#endif
+
+G_BEGIN_DECLS
+
+/* Probes are emitted under the "pygobject" provider, in entry/return pairs
+ * carrying the full name of the GI callable (e.g. "Gio.File.query_info"):
+ *
+ *  - invoke__entry, invoke__return: calling a C function from Python
+ *  - closure__entry, closure__return: calling a Python callback from C
+ *  - signal__entry, signal__return: emitting a signal to a Python handler
+ *  - async__finish__entry, async__finish__return: completing a gi.Async
+ *
+ * The name is only computed while a tracer is attached to one of the
+ * probes of a pair, so disabled probes cost a single load and branch.
+ */
+
+#ifdef HAVE_DTRACE
+
+#define PYGI_TRACE_SEMAPHORE(probe) pygobject_##probe##_semaphore
+
+#define PYGI_TRACE_DECLARE_PROBE(probe)                                       \
+    extern unsigned short PYGI_TRACE_SEMAPHORE (probe)                        \
+        __attribute__ ((unused)) __attribute__ ((section (".probes")))
+
+PYGI_TRACE_DECLARE_PROBE (invoke__entry);
+PYGI_TRACE_DECLARE_PROBE (invoke__return);
+PYGI_TRACE_DECLARE_PROBE (closure__entry);
+PYGI_TRACE_DECLARE_PROBE (closure__return);
+PYGI_TRACE_DECLARE_PROBE (signal__entry);
+PYGI_TRACE_DECLARE_PROBE (signal__return);
+PYGI_TRACE_DECLARE_PROBE (async__finish__entry);
+PYGI_TRACE_DECLARE_PROBE (async__finish__return);
+
+#define PYGI_TRACE_ENABLED(probe) G_UNLIKELY (PYGI_TRACE_SEMAPHORE (probe))
+
+/**
+ * PYGI_TRACE_ENTRY:
+ * @prefix: the probe pair, e.g. invoke
+ * @name: a gchar * variable which receives the traced name
+ * @name_expr: expression returning a newly allocated name
+ *
+ * Fires the @prefix__entry probe. @name_expr is only evaluated when a
+ * tracer is attached, the result must be released by PYGI_TRACE_RETURN().
+ */
+#define PYGI_TRACE_ENTRY(prefix, name, name_expr)                             \
+    G_STMT_START                                                              \
+    {                                                                         \
+        if (PYGI_TRACE_ENABLED (prefix##__entry)                              \
+            || PYGI_TRACE_ENABLED (prefix##__return))                         \
+            (name) = (name_expr);                                             \
+        STAP_PROBE1 (pygobject, prefix##__entry, (name));                     \
+    }                                                                         \
+    G_STMT_END
+
+#define PYGI_TRACE_RETURN(prefix, name)                                       \
+    G_STMT_START                                                              \
+    {                                                                         \
+        STAP_PROBE1 (pygobject, prefix##__return, (name));                    \
+        g_clear_pointer (&(name), g_free);                                    \
+    }                                                                         \
+    G_STMT_END
+
+#else /* !HAVE_DTRACE */
+
+#define PYGI_TRACE_ENTRY(prefix, name, name_expr) (void)(name)
+#define PYGI_TRACE_RETURN(prefix, name)           (void)(name)
+
+#endif /* HAVE_DTRACE */
+
+G_END_DECLS
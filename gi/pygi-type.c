@@ -715,6 +715,11 @@ pyg_flags_get_value (GType flag_type, PyObject *obj, guint *val)
 
 static GQuark pyg_type_marshal_key = 0;
 static GQuark pyg_type_marshal_helper_key = 0;
+static GQuark pyg_type_marshal_cache_key = 0;
+
+/* Incremented by pyg_register_gtype_custom(), invalidates the lookup results
+ * cached under pyg_type_marshal_cache_key */
+static guint pyg_type_marshal_serial = 1;
 
 typedef enum _marshal_helper_data_e marshal_helper_data_e;
 enum _marshal_helper_data_e {
@@ -723,38 +728,57 @@ enum _marshal_helper_data_e {
     MARSHAL_HELPER_IMPORT_DONE,
 };
 
+typedef struct {
+    guint serial;
+    PyGTypeMarshal *tm;
+} PyGTypeMarshalCache;
+
 PyGTypeMarshal *
 pyg_type_lookup (GType type)
 {
     GType ptype = type;
     PyGTypeMarshal *tm = NULL;
+    PyGTypeMarshalCache *cache;
     marshal_helper_data_e marshal_helper;
 
     if (type == G_TYPE_INVALID) return NULL;
 
+    /* The result of a previous lookup, as long as no marshaller was
+     * registered since then */
+    cache = g_type_get_qdata (type, pyg_type_marshal_cache_key);
+    if (cache != NULL && cache->serial == pyg_type_marshal_serial)
+        return cache->tm;
+
     marshal_helper =
         GPOINTER_TO_INT (g_type_get_qdata (type, pyg_type_marshal_helper_key));
 
-    /* If we called this function before with @type and nothing was found,
-     * return NULL early to not spend time in the loop below */
-    if (marshal_helper == MARSHAL_HELPER_RETURN_NULL) return NULL;
-
     /* Otherwise do recursive type lookup */
     do {
         if (marshal_helper == MARSHAL_HELPER_IMPORT_DONE)
-            pygi_type_import_by_g_type (ptype);
+            Py_XDECREF (pygi_type_import_by_g_type (ptype));
 
         if ((tm = g_type_get_qdata (ptype, pyg_type_marshal_key)) != NULL)
             break;
         ptype = g_type_parent (ptype);
     } while (ptype);
 
+    /* The first time a marshaller is found, look again with the wrappers of
+     * the type hierarchy imported before caching it */
     if (marshal_helper == MARSHAL_HELPER_NONE) {
         marshal_helper = (tm == NULL) ? MARSHAL_HELPER_RETURN_NULL
                                       : MARSHAL_HELPER_IMPORT_DONE;
         g_type_set_qdata (type, pyg_type_marshal_helper_key,
                           GINT_TO_POINTER (marshal_helper));
+        if (tm != NULL) return tm;
+    }
+
+    if (cache == NULL) {
+        cache = g_new (PyGTypeMarshalCache, 1);
+        g_type_set_qdata (type, pyg_type_marshal_cache_key, cache);
     }
+    cache->serial = pyg_type_marshal_serial;
+    cache->tm = tm;
+
     return tm;
 }
 
@@ -779,12 +803,16 @@ pyg_register_gtype_custom (GType gtype, fromvaluefunc from_func,
         pyg_type_marshal_key = g_quark_from_static_string ("PyGType::marshal");
         pyg_type_marshal_helper_key =
             g_quark_from_static_string ("PyGType::marshal-helper");
+        pyg_type_marshal_cache_key =
+            g_quark_from_static_string ("PyGType::marshal-cache");
     }
 
     tm = g_new (PyGTypeMarshal, 1);
     tm->fromvalue = from_func;
     tm->tovalue = to_func;
     g_type_set_qdata (gtype, pyg_type_marshal_key, tm);
+
+    pyg_type_marshal_serial++;
 }
 
 /* -------------- PyGClosure ----------------- */
@@ -315,314 +315,847 @@ pyg_array_from_pyobject (GValue *value, PyObject *obj)
     return 0;
 }
 
-/**
- * pyg_value_from_pyobject_with_error:
- * @value: the GValue object to store the converted value in.
- * @obj: the Python object to convert.
- *
- * This function converts a Python object and stores the result in a
- * GValue.  The GValue must be initialised in advance with
- * g_value_init().  If the Python object can't be converted to the
- * type of the GValue, then an error is returned.
+/* Per-type converters between GValues and Python objects.
  *
- * Returns: 0 on success, -1 on error.
- */
-int
-pyg_value_from_pyobject_with_error (GValue *value, PyObject *obj)
+ * Basic and structured fundamental types are dispatched through
+ * fundamental_converters[], boxed and interface types additionally depend on
+ * the concrete type, so their converter is resolved once per GType and kept
+ * in its qdata. Converting a GValue is then a single indirect call instead of
+ * a walk through the type hierarchy. */
+
+typedef PyObject *(*PyGIValueToPyFunc) (const GValue *value,
+                                        gboolean copy_boxed);
+
+typedef struct {
+    tovaluefunc from_py;
+    PyGIValueToPyFunc to_py;
+} PyGIValueConverter;
+
+static GQuark pygi_value_converter_key = 0;
+
+/* If an error occurred, unset the GValue but don't clear the Python error. */
+static int
+value_from_py_check_error (GValue *value)
 {
-    GType value_type = G_VALUE_TYPE (value);
+    if (PyErr_Occurred ()) {
+        g_value_unset (value);
+        return -1;
+    }
 
-    switch (G_TYPE_FUNDAMENTAL (value_type)) {
-    case G_TYPE_INTERFACE:
-        /* we only handle interface types that have a GObject prereq */
-        if (g_type_is_a (value_type, G_TYPE_OBJECT)) {
-            if (Py_IsNone (obj))
-                g_value_set_object (value, NULL);
-            else {
-                if (!PyObject_TypeCheck (obj, &PyGObject_Type)) {
-                    PyErr_SetString (PyExc_TypeError, "GObject is required");
-                    return -1;
-                }
-                if (!G_TYPE_CHECK_INSTANCE_TYPE (pygobject_get (obj),
-                                                 value_type)) {
-                    PyErr_SetString (PyExc_TypeError,
-                                     "Invalid GObject type for assignment");
-                    return -1;
-                }
-                g_value_set_object (value, pygobject_get (obj));
-            }
-        } else {
-            PyErr_SetString (PyExc_TypeError, "Unsupported conversion");
+    return 0;
+}
+
+static int
+value_from_py_interface_object (GValue *value, PyObject *obj)
+{
+    if (Py_IsNone (obj))
+        g_value_set_object (value, NULL);
+    else {
+        if (!PyObject_TypeCheck (obj, &PyGObject_Type)) {
+            PyErr_SetString (PyExc_TypeError, "GObject is required");
             return -1;
         }
-        break;
-    case G_TYPE_CHAR: {
-        gint8 temp;
-        if (pygi_gschar_from_py (obj, &temp)) {
-            g_value_set_schar (value, temp);
-            return 0;
-        } else
-            return -1;
-    }
-    case G_TYPE_UCHAR: {
-        guchar temp;
-        if (pygi_guchar_from_py (obj, &temp)) {
-            g_value_set_uchar (value, temp);
-            return 0;
-        } else
-            return -1;
-    }
-    case G_TYPE_BOOLEAN: {
-        gboolean temp;
-        if (pygi_gboolean_from_py (obj, &temp)) {
-            g_value_set_boolean (value, temp);
-            return 0;
-        } else
-            return -1;
-    }
-    case G_TYPE_INT: {
-        gint temp;
-        if (pygi_gint_from_py (obj, &temp)) {
-            g_value_set_int (value, temp);
-            return 0;
-        } else
+        if (!G_TYPE_CHECK_INSTANCE_TYPE (pygobject_get (obj),
+                                         G_VALUE_TYPE (value))) {
+            PyErr_SetString (PyExc_TypeError,
+                             "Invalid GObject type for assignment");
             return -1;
+        }
+        g_value_set_object (value, pygobject_get (obj));
     }
-    case G_TYPE_UINT: {
-        guint temp;
-        if (pygi_guint_from_py (obj, &temp)) {
-            g_value_set_uint (value, temp);
-            return 0;
-        } else
-            return -1;
+
+    return value_from_py_check_error (value);
+}
+
+static int
+value_from_py_interface_unsupported (GValue *value, PyObject *obj)
+{
+    PyErr_SetString (PyExc_TypeError, "Unsupported conversion");
+    return -1;
+}
+
+static int
+value_from_py_char (GValue *value, PyObject *obj)
+{
+    gint8 temp;
+    if (pygi_gschar_from_py (obj, &temp)) {
+        g_value_set_schar (value, temp);
+        return 0;
+    } else
+        return -1;
+}
+
+static int
+value_from_py_uchar (GValue *value, PyObject *obj)
+{
+    guchar temp;
+    if (pygi_guchar_from_py (obj, &temp)) {
+        g_value_set_uchar (value, temp);
+        return 0;
+    } else
+        return -1;
+}
+
+static int
+value_from_py_boolean (GValue *value, PyObject *obj)
+{
+    gboolean temp;
+    if (pygi_gboolean_from_py (obj, &temp)) {
+        g_value_set_boolean (value, temp);
+        return 0;
+    } else
+        return -1;
+}
+
+static int
+value_from_py_int (GValue *value, PyObject *obj)
+{
+    gint temp;
+    if (pygi_gint_from_py (obj, &temp)) {
+        g_value_set_int (value, temp);
+        return 0;
+    } else
+        return -1;
+}
+
+static int
+value_from_py_uint (GValue *value, PyObject *obj)
+{
+    guint temp;
+    if (pygi_guint_from_py (obj, &temp)) {
+        g_value_set_uint (value, temp);
+        return 0;
+    } else
+        return -1;
+}
+
+static int
+value_from_py_long (GValue *value, PyObject *obj)
+{
+    glong temp;
+    if (pygi_glong_from_py (obj, &temp)) {
+        g_value_set_long (value, temp);
+        return 0;
+    } else
+        return -1;
+}
+
+static int
+value_from_py_ulong (GValue *value, PyObject *obj)
+{
+    gulong temp;
+    if (pygi_gulong_from_py (obj, &temp)) {
+        g_value_set_ulong (value, temp);
+        return 0;
+    } else
+        return -1;
+}
+
+static int
+value_from_py_int64 (GValue *value, PyObject *obj)
+{
+    gint64 temp;
+    if (pygi_gint64_from_py (obj, &temp)) {
+        g_value_set_int64 (value, temp);
+        return 0;
+    } else
+        return -1;
+}
+
+static int
+value_from_py_uint64 (GValue *value, PyObject *obj)
+{
+    guint64 temp;
+    if (pygi_guint64_from_py (obj, &temp)) {
+        g_value_set_uint64 (value, temp);
+        return 0;
+    } else
+        return -1;
+}
+
+static int
+value_from_py_enum (GValue *value, PyObject *obj)
+{
+    gint val = 0;
+    if (pyg_enum_get_value (G_VALUE_TYPE (value), obj, &val) < 0) {
+        return -1;
     }
-    case G_TYPE_LONG: {
-        glong temp;
-        if (pygi_glong_from_py (obj, &temp)) {
-            g_value_set_long (value, temp);
-            return 0;
-        } else
-            return -1;
+    g_value_set_enum (value, val);
+    return value_from_py_check_error (value);
+}
+
+static int
+value_from_py_flags (GValue *value, PyObject *obj)
+{
+    guint val = 0;
+    if (pyg_flags_get_value (G_VALUE_TYPE (value), obj, &val) < 0) {
+        return -1;
     }
-    case G_TYPE_ULONG: {
-        gulong temp;
-        if (pygi_gulong_from_py (obj, &temp)) {
-            g_value_set_ulong (value, temp);
+    g_value_set_flags (value, val);
+    return 0;
+}
+
+static int
+value_from_py_float (GValue *value, PyObject *obj)
+{
+    gfloat temp;
+    if (pygi_gfloat_from_py (obj, &temp)) {
+        g_value_set_float (value, temp);
+        return 0;
+    } else
+        return -1;
+}
+
+static int
+value_from_py_double (GValue *value, PyObject *obj)
+{
+    gdouble temp;
+    if (pygi_gdouble_from_py (obj, &temp)) {
+        g_value_set_double (value, temp);
+        return 0;
+    } else
+        return -1;
+}
+
+static int
+value_from_py_string (GValue *value, PyObject *obj)
+{
+    gchar *temp;
+    if (pygi_utf8_from_py (obj, &temp)) {
+        g_value_take_string (value, temp);
+        return 0;
+    } else {
+        /* also allows setting anything implementing __str__ */
+        PyObject *str;
+        PyErr_Clear ();
+        str = PyObject_Str (obj);
+        if (str == NULL) return -1;
+        if (pygi_utf8_from_py (str, &temp)) {
+            Py_DECREF (str);
+            g_value_take_string (value, temp);
             return 0;
-        } else
-            return -1;
+        }
+        Py_DECREF (str);
+        return -1;
     }
-    case G_TYPE_INT64: {
-        gint64 temp;
-        if (pygi_gint64_from_py (obj, &temp)) {
-            g_value_set_int64 (value, temp);
-            return 0;
-        } else
-            return -1;
+}
+
+static int
+value_from_py_pointer (GValue *value, PyObject *obj)
+{
+    if (Py_IsNone (obj))
+        g_value_set_pointer (value, NULL);
+    else if (PyObject_TypeCheck (obj, &PyGPointer_Type)
+             && G_VALUE_HOLDS (value, ((PyGPointer *)obj)->gtype))
+        g_value_set_pointer (value, pyg_pointer_get (obj, gpointer));
+    else if (PyCapsule_CheckExact (obj))
+        g_value_set_pointer (value, PyCapsule_GetPointer (obj, NULL));
+    else if (G_VALUE_HOLDS_GTYPE (value))
+        g_value_set_gtype (value, pyg_type_from_object (obj));
+    else {
+        PyErr_SetString (PyExc_TypeError, "Expected pointer");
+        return -1;
     }
-    case G_TYPE_UINT64: {
-        guint64 temp;
-        if (pygi_guint64_from_py (obj, &temp)) {
-            g_value_set_uint64 (value, temp);
-            return 0;
-        } else
-            return -1;
+
+    return value_from_py_check_error (value);
+}
+
+/* Handles the conversions shared by all boxed types, returns FALSE if @obj
+ * needs a type specific conversion. */
+static gboolean
+value_from_py_boxed_common (GValue *value, PyObject *obj)
+{
+    if (Py_IsNone (obj))
+        g_value_set_boxed (value, NULL);
+    else if (PyObject_TypeCheck (obj, &PyGBoxed_Type)
+             && G_VALUE_HOLDS (value, ((PyGBoxed *)obj)->gtype))
+        g_value_set_boxed (value, pyg_boxed_get (obj, gpointer));
+    else
+        return FALSE;
+
+    return TRUE;
+}
+
+static int
+value_from_py_boxed_custom (GValue *value, PyObject *obj)
+{
+    PyGTypeMarshal *bm;
+
+    if ((bm = pyg_type_lookup (G_VALUE_TYPE (value))) != NULL)
+        return bm->tovalue (value, obj);
+    else if (PyCapsule_CheckExact (obj))
+        g_value_set_boxed (value, PyCapsule_GetPointer (obj, NULL));
+    else {
+        PyErr_SetString (PyExc_TypeError, "Expected Boxed");
+        return -1;
     }
-    case G_TYPE_ENUM: {
-        gint val = 0;
-        if (pyg_enum_get_value (G_VALUE_TYPE (value), obj, &val) < 0) {
-            return -1;
-        }
-        g_value_set_enum (value, val);
-        break;
+
+    return value_from_py_check_error (value);
+}
+
+static int
+value_from_py_boxed_pyobject (GValue *value, PyObject *obj)
+{
+    if (Py_IsNone (obj))
+        g_value_set_boxed (value, NULL);
+    else
+        g_value_set_boxed (value, obj);
+
+    return value_from_py_check_error (value);
+}
+
+static int
+value_from_py_boxed_value (GValue *value, PyObject *obj)
+{
+    GType type;
+    GValue *n_value;
+
+    if (value_from_py_boxed_common (value, obj))
+        return value_from_py_check_error (value);
+
+    type = pyg_type_from_object ((PyObject *)Py_TYPE (obj));
+    if (G_UNLIKELY (!type)) {
+        return -1;
     }
-    case G_TYPE_FLAGS: {
-        guint val = 0;
-        if (pyg_flags_get_value (G_VALUE_TYPE (value), obj, &val) < 0) {
-            return -1;
-        }
-        g_value_set_flags (value, val);
-        return 0;
+    n_value = g_new0 (GValue, 1);
+    g_value_init (n_value, type);
+    g_value_take_boxed (value, n_value);
+    return pyg_value_from_pyobject_with_error (n_value, obj);
+}
+
+static int
+value_from_py_boxed_value_array (GValue *value, PyObject *obj)
+{
+    if (value_from_py_boxed_common (value, obj))
+        return value_from_py_check_error (value);
+
+    if (PySequence_Check (obj))
+        return pyg_value_array_from_pyobject (value, obj, NULL);
+
+    return value_from_py_boxed_custom (value, obj);
+}
+
+static int
+value_from_py_boxed_array (GValue *value, PyObject *obj)
+{
+    if (value_from_py_boxed_common (value, obj))
+        return value_from_py_check_error (value);
+
+    if (PySequence_Check (obj)) return pyg_array_from_pyobject (value, obj);
+
+    return value_from_py_boxed_custom (value, obj);
+}
+
+static int
+value_from_py_boxed_gstring (GValue *value, PyObject *obj)
+{
+    if (value_from_py_boxed_common (value, obj))
+        return value_from_py_check_error (value);
+
+    if (PyUnicode_Check (obj)) {
+        GString *string;
+        const char *buffer;
+        Py_ssize_t len;
+        buffer = PyUnicode_AsUTF8AndSize (obj, &len);
+        if (buffer == NULL) return -1;
+        string = g_string_new_len (buffer, len);
+        g_value_set_boxed (value, string);
+        g_string_free (string, TRUE);
+        return value_from_py_check_error (value);
     }
-    case G_TYPE_FLOAT: {
-        gfloat temp;
-        if (pygi_gfloat_from_py (obj, &temp)) {
-            g_value_set_float (value, temp);
-            return 0;
-        } else
-            return -1;
+
+    return value_from_py_boxed_custom (value, obj);
+}
+
+static int
+value_from_py_boxed (GValue *value, PyObject *obj)
+{
+    if (value_from_py_boxed_common (value, obj))
+        return value_from_py_check_error (value);
+
+    return value_from_py_boxed_custom (value, obj);
+}
+
+static int
+value_from_py_object (GValue *value, PyObject *obj)
+{
+    if (Py_IsNone (obj)) {
+        g_value_set_object (value, NULL);
+    } else if (PyObject_TypeCheck (obj, &PyGObject_Type)
+               && G_TYPE_CHECK_INSTANCE_TYPE (pygobject_get (obj),
+                                              G_VALUE_TYPE (value))) {
+        g_value_set_object (value, pygobject_get (obj));
+    } else {
+        PyErr_SetString (PyExc_TypeError, "Expected GObject");
+        return -1;
     }
-    case G_TYPE_DOUBLE: {
-        gdouble temp;
-        if (pygi_gdouble_from_py (obj, &temp)) {
-            g_value_set_double (value, temp);
-            return 0;
-        } else
-            return -1;
+
+    return value_from_py_check_error (value);
+}
+
+static int
+value_from_py_variant (GValue *value, PyObject *obj)
+{
+    if (Py_IsNone (obj))
+        g_value_set_variant (value, NULL);
+    else if (pyg_type_from_object_strict (obj, FALSE) == G_TYPE_VARIANT)
+        g_value_set_variant (value, pyg_boxed_get (obj, GVariant));
+    else {
+        PyErr_SetString (PyExc_TypeError, "Expected Variant");
+        return -1;
     }
-    case G_TYPE_STRING: {
-        gchar *temp;
-        if (pygi_utf8_from_py (obj, &temp)) {
-            g_value_take_string (value, temp);
-            return 0;
-        } else {
-            /* also allows setting anything implementing __str__ */
-            PyObject *str;
-            PyErr_Clear ();
-            str = PyObject_Str (obj);
-            if (str == NULL) return -1;
-            if (pygi_utf8_from_py (str, &temp)) {
-                Py_DECREF (str);
-                g_value_take_string (value, temp);
-                return 0;
-            }
-            Py_DECREF (str);
+
+    return value_from_py_check_error (value);
+}
+
+static int
+value_from_py_fundamental (GValue *value, PyObject *obj)
+{
+    GType value_type = G_VALUE_TYPE (value);
+    PyGTypeMarshal *bm;
+
+    if ((bm = pyg_type_lookup (value_type)) != NULL) {
+        return bm->tovalue (value, obj);
+    } else {
+        GIRepository *repository;
+        GIBaseInfo *info;
+        GIObjectInfoSetValueFunction set_value_func = NULL;
+
+        if (!PyObject_TypeCheck (obj, &PyGIFundamental_Type)) {
+            PyErr_SetString (PyExc_TypeError, "Fundamental type is required");
             return -1;
         }
-    }
-    case G_TYPE_POINTER:
-        if (Py_IsNone (obj))
-            g_value_set_pointer (value, NULL);
-        else if (PyObject_TypeCheck (obj, &PyGPointer_Type)
-                 && G_VALUE_HOLDS (value, ((PyGPointer *)obj)->gtype))
-            g_value_set_pointer (value, pyg_pointer_get (obj, gpointer));
-        else if (PyCapsule_CheckExact (obj))
-            g_value_set_pointer (value, PyCapsule_GetPointer (obj, NULL));
-        else if (G_VALUE_HOLDS_GTYPE (value))
-            g_value_set_gtype (value, pyg_type_from_object (obj));
-        else {
-            PyErr_SetString (PyExc_TypeError, "Expected pointer");
+        if (!G_TYPE_CHECK_INSTANCE_TYPE (pygi_fundamental_get (obj),
+                                         value_type)) {
+            PyErr_SetString (PyExc_TypeError,
+                             "Invalid fundamental type for assignment");
             return -1;
         }
-        break;
-    case G_TYPE_BOXED: {
-        PyGTypeMarshal *bm;
-        gboolean holds_value_array;
-
-        G_GNUC_BEGIN_IGNORE_DEPRECATIONS
-        holds_value_array = G_VALUE_HOLDS (value, PYGI_TYPE_VALUE_ARRAY);
-        G_GNUC_END_IGNORE_DEPRECATIONS
-
-        if (Py_IsNone (obj))
-            g_value_set_boxed (value, NULL);
-        else if (G_VALUE_HOLDS (value, PY_TYPE_OBJECT))
-            g_value_set_boxed (value, obj);
-        else if (PyObject_TypeCheck (obj, &PyGBoxed_Type)
-                 && G_VALUE_HOLDS (value, ((PyGBoxed *)obj)->gtype))
-            g_value_set_boxed (value, pyg_boxed_get (obj, gpointer));
-        else if (G_VALUE_HOLDS (value, G_TYPE_VALUE)) {
-            GType type;
-            GValue *n_value;
-
-            type = pyg_type_from_object ((PyObject *)Py_TYPE (obj));
-            if (G_UNLIKELY (!type)) {
-                return -1;
+
+        repository = pygi_repository_get_default ();
+        info = gi_repository_find_by_gtype (repository, value_type);
+
+        if (info && GI_IS_OBJECT_INFO (info)) {
+            set_value_func = gi_object_info_get_set_value_function_pointer (
+                (GIObjectInfo *)info);
+            if (set_value_func) {
+                set_value_func (value, pygi_fundamental_get (obj));
+            } else {
+                PyErr_SetString (PyExc_TypeError,
+                                 "No set-value function for fundamental type");
             }
-            n_value = g_new0 (GValue, 1);
-            g_value_init (n_value, type);
-            g_value_take_boxed (value, n_value);
-            return pyg_value_from_pyobject_with_error (n_value, obj);
-        } else if (PySequence_Check (obj) && holds_value_array)
-            return pyg_value_array_from_pyobject (value, obj, NULL);
-
-        else if (PySequence_Check (obj) && G_VALUE_HOLDS (value, G_TYPE_ARRAY))
-            return pyg_array_from_pyobject (value, obj);
-        else if (PyUnicode_Check (obj)
-                 && G_VALUE_HOLDS (value, G_TYPE_GSTRING)) {
-            GString *string;
-            char *buffer;
-            Py_ssize_t len;
-            buffer = PyUnicode_AsUTF8AndSize (obj, &len);
-            if (buffer == NULL) return -1;
-            string = g_string_new_len (buffer, len);
-            g_value_set_boxed (value, string);
-            g_string_free (string, TRUE);
-            break;
-        } else if ((bm = pyg_type_lookup (G_VALUE_TYPE (value))) != NULL)
-            return bm->tovalue (value, obj);
-        else if (PyCapsule_CheckExact (obj))
-            g_value_set_boxed (value, PyCapsule_GetPointer (obj, NULL));
-        else {
-            PyErr_SetString (PyExc_TypeError, "Expected Boxed");
-            return -1;
-        }
-        break;
-    }
-    case G_TYPE_OBJECT:
-        if (Py_IsNone (obj)) {
-            g_value_set_object (value, NULL);
-        } else if (PyObject_TypeCheck (obj, &PyGObject_Type)
-                   && G_TYPE_CHECK_INSTANCE_TYPE (pygobject_get (obj),
-                                                  G_VALUE_TYPE (value))) {
-            g_value_set_object (value, pygobject_get (obj));
         } else {
-            PyErr_SetString (PyExc_TypeError, "Expected GObject");
-            return -1;
-        }
-        break;
-    case G_TYPE_VARIANT: {
-        if (Py_IsNone (obj))
-            g_value_set_variant (value, NULL);
-        else if (pyg_type_from_object_strict (obj, FALSE) == G_TYPE_VARIANT)
-            g_value_set_variant (value, pyg_boxed_get (obj, GVariant));
-        else {
-            PyErr_SetString (PyExc_TypeError, "Expected Variant");
-            return -1;
+            PyErr_SetString (PyExc_TypeError, "Unknown value type");
         }
-        break;
+
+        if (info) gi_base_info_unref (info);
     }
-    default: {
-        PyGTypeMarshal *bm;
-        if ((bm = pyg_type_lookup (G_VALUE_TYPE (value))) != NULL) {
-            return bm->tovalue (value, obj);
-        } else {
-            GIRepository *repository;
-            GIBaseInfo *info;
-            GIObjectInfoSetValueFunction set_value_func = NULL;
 
-            if (!PyObject_TypeCheck (obj, &PyGIFundamental_Type)) {
-                PyErr_SetString (PyExc_TypeError,
-                                 "Fundamental type is required");
-                return -1;
-            }
-            if (!G_TYPE_CHECK_INSTANCE_TYPE (pygi_fundamental_get (obj),
-                                             value_type)) {
-                PyErr_SetString (PyExc_TypeError,
-                                 "Invalid fundamental type for assignment");
-                return -1;
-            }
+    return value_from_py_check_error (value);
+}
 
-            repository = pygi_repository_get_default ();
-            info = gi_repository_find_by_gtype (repository, value_type);
-
-            if (info && GI_IS_OBJECT_INFO (info)) {
-                set_value_func =
-                    gi_object_info_get_set_value_function_pointer (
-                        (GIObjectInfo *)info);
-                if (set_value_func) {
-                    set_value_func (value, pygi_fundamental_get (obj));
-                } else {
-                    PyErr_SetString (
-                        PyExc_TypeError,
-                        "No set-value function for fundamental type");
-                }
-            } else {
-                PyErr_SetString (PyExc_TypeError, "Unknown value type");
-            }
+static PyObject *
+value_to_py_unknown (const GValue *value)
+{
+    const gchar *type_name;
 
-            if (info) gi_base_info_unref (info);
-        }
-        break;
+    type_name = g_type_name (G_VALUE_TYPE (value));
+    if (type_name == NULL) {
+        type_name = "(null)";
     }
+    PyErr_Format (PyExc_TypeError, "unknown type %s", type_name);
+    return NULL;
+}
+
+static PyObject *
+value_to_py_invalid (const GValue *value, gboolean copy_boxed)
+{
+    PyErr_SetString (PyExc_TypeError, "Invalid type");
+    return NULL;
+}
+
+static PyObject *
+value_to_py_interface_object (const GValue *value, gboolean copy_boxed)
+{
+    return pygobject_new (g_value_get_object (value));
+}
+
+static PyObject *
+value_to_py_interface_unsupported (const GValue *value, gboolean copy_boxed)
+{
+    return value_to_py_unknown (value);
+}
+
+/* HACK: special case char and uchar to return PyBytes intstead of integers
+ * in the general case. Property access will skip this by calling
+ * pygi_value_to_py_basic_type() directly.
+ * See: https://bugzilla.gnome.org/show_bug.cgi?id=733893 */
+static PyObject *
+value_to_py_char (const GValue *value, gboolean copy_boxed)
+{
+    gint8 val = g_value_get_schar (value);
+    return PyUnicode_FromStringAndSize ((char *)&val, 1);
+}
+
+static PyObject *
+value_to_py_uchar (const GValue *value, gboolean copy_boxed)
+{
+    guint8 val = g_value_get_uchar (value);
+    return PyBytes_FromStringAndSize ((char *)&val, 1);
+}
+
+static PyObject *
+value_to_py_boolean (const GValue *value, gboolean copy_boxed)
+{
+    return pygi_gboolean_to_py (g_value_get_boolean (value));
+}
+
+static PyObject *
+value_to_py_int (const GValue *value, gboolean copy_boxed)
+{
+    return pygi_gint_to_py (g_value_get_int (value));
+}
+
+static PyObject *
+value_to_py_uint (const GValue *value, gboolean copy_boxed)
+{
+    return pygi_guint_to_py (g_value_get_uint (value));
+}
+
+static PyObject *
+value_to_py_long (const GValue *value, gboolean copy_boxed)
+{
+    return pygi_glong_to_py (g_value_get_long (value));
+}
+
+static PyObject *
+value_to_py_ulong (const GValue *value, gboolean copy_boxed)
+{
+    return pygi_gulong_to_py (g_value_get_ulong (value));
+}
+
+static PyObject *
+value_to_py_int64 (const GValue *value, gboolean copy_boxed)
+{
+    return pygi_gint64_to_py (g_value_get_int64 (value));
+}
+
+static PyObject *
+value_to_py_uint64 (const GValue *value, gboolean copy_boxed)
+{
+    return pygi_guint64_to_py (g_value_get_uint64 (value));
+}
+
+static PyObject *
+value_to_py_enum (const GValue *value, gboolean copy_boxed)
+{
+    return pyg_enum_from_gtype (G_VALUE_TYPE (value), g_value_get_enum (value));
+}
+
+static PyObject *
+value_to_py_flags (const GValue *value, gboolean copy_boxed)
+{
+    return pyg_flags_from_gtype (G_VALUE_TYPE (value),
+                                 g_value_get_flags (value));
+}
+
+static PyObject *
+value_to_py_float (const GValue *value, gboolean copy_boxed)
+{
+    return pygi_gfloat_to_py (g_value_get_float (value));
+}
+
+static PyObject *
+value_to_py_double (const GValue *value, gboolean copy_boxed)
+{
+    return pygi_gdouble_to_py (g_value_get_double (value));
+}
+
+static PyObject *
+value_to_py_string (const GValue *value, gboolean copy_boxed)
+{
+    return pygi_utf8_to_py (g_value_get_string (value));
+}
+
+static PyObject *
+value_to_py_pointer (const GValue *value, gboolean copy_boxed)
+{
+    if (G_VALUE_HOLDS_GTYPE (value))
+        return pyg_type_wrapper_new (g_value_get_gtype (value));
+    else
+        return pyg_pointer_new (G_VALUE_TYPE (value),
+                                g_value_get_pointer (value));
+}
+
+static PyObject *
+value_to_py_boxed_pyobject (const GValue *value, gboolean copy_boxed)
+{
+    PyObject *ret = (PyObject *)g_value_dup_boxed (value);
+    if (ret == NULL) {
+        Py_RETURN_NONE;
     }
+    return ret;
+}
 
-    /* If an error occurred, unset the GValue but don't clear the Python error. */
-    if (PyErr_Occurred ()) {
-        g_value_unset (value);
-        return -1;
+static PyObject *
+value_to_py_boxed_value (const GValue *value, gboolean copy_boxed)
+{
+    GValue *n_value = g_value_get_boxed (value);
+    return pyg_value_to_pyobject (n_value, copy_boxed);
+}
+
+static PyObject *
+value_to_py_boxed_value_array (const GValue *value, gboolean copy_boxed)
+{
+    GValueArray *array = (GValueArray *)g_value_get_boxed (value);
+    Py_ssize_t n_values = array ? array->n_values : 0;
+    PyObject *ret = PyList_New (n_values);
+    int i;
+    for (i = 0; i < n_values; ++i)
+        PyList_SET_ITEM (ret, i,
+                         pyg_value_to_pyobject (array->values + i, copy_boxed));
+    return ret;
+}
+
+static PyObject *
+value_to_py_boxed_gstring (const GValue *value, gboolean copy_boxed)
+{
+    GString *string = (GString *)g_value_get_boxed (value);
+    PyObject *ret = PyUnicode_FromStringAndSize (string->str, string->len);
+    return ret;
+}
+
+static PyObject *
+value_to_py_boxed (const GValue *value, gboolean copy_boxed)
+{
+    PyGTypeMarshal *bm;
+
+    bm = pyg_type_lookup (G_VALUE_TYPE (value));
+    if (bm) {
+        return bm->fromvalue (value);
+    } else {
+        if (copy_boxed)
+            return pygi_gboxed_new (G_VALUE_TYPE (value),
+                                    g_value_get_boxed (value), TRUE, TRUE);
+        else
+            return pygi_gboxed_new (G_VALUE_TYPE (value),
+                                    g_value_get_boxed (value), FALSE, FALSE);
     }
+}
 
-    return 0;
+static PyObject *
+value_to_py_object (const GValue *value, gboolean copy_boxed)
+{
+    return pygobject_new (g_value_get_object (value));
+}
+
+static PyObject *
+value_to_py_variant (const GValue *value, gboolean copy_boxed)
+{
+    GVariant *v = g_value_get_variant (value);
+    if (v == NULL) {
+        Py_RETURN_NONE;
+    }
+    return pygi_struct_new_from_g_type (G_TYPE_VARIANT, g_variant_ref (v),
+                                        FALSE);
+}
+
+static PyObject *
+value_to_py_fundamental (const GValue *value, gboolean copy_boxed)
+{
+    GType fundamental = G_TYPE_FUNDAMENTAL (G_VALUE_TYPE (value));
+    PyGTypeMarshal *bm;
+    GIRepository *repository;
+    GIBaseInfo *info;
+    GIObjectInfoGetValueFunction get_value_func = NULL;
+
+    if ((bm = pyg_type_lookup (G_VALUE_TYPE (value))))
+        return bm->fromvalue (value);
+
+    repository = pygi_repository_get_default ();
+    info = gi_repository_find_by_gtype (repository, fundamental);
+
+    if (info == NULL) return value_to_py_unknown (value);
+
+    if (GI_IS_OBJECT_INFO (info))
+        get_value_func = gi_object_info_get_get_value_function_pointer (
+            (GIObjectInfo *)info);
+
+    gi_base_info_unref (info);
+
+    if (get_value_func) return pygi_fundamental_new (get_value_func (value));
+
+    return value_to_py_unknown (value);
+}
+
+#define FUNDAMENTAL_INDEX(type) ((type) >> G_TYPE_FUNDAMENTAL_SHIFT)
+
+/* Types not listed here (G_TYPE_PARAM, G_TYPE_NONE and custom fundamentals)
+ * go through fundamental_converter */
+static const PyGIValueConverter
+    fundamental_converters[FUNDAMENTAL_INDEX (G_TYPE_FUNDAMENTAL_MAX) + 1] = {
+        [FUNDAMENTAL_INDEX (G_TYPE_INVALID)] = { value_from_py_fundamental,
+                                                 value_to_py_invalid },
+        [FUNDAMENTAL_INDEX (G_TYPE_CHAR)] = { value_from_py_char,
+                                              value_to_py_char },
+        [FUNDAMENTAL_INDEX (G_TYPE_UCHAR)] = { value_from_py_uchar,
+                                               value_to_py_uchar },
+        [FUNDAMENTAL_INDEX (G_TYPE_BOOLEAN)] = { value_from_py_boolean,
+                                                 value_to_py_boolean },
+        [FUNDAMENTAL_INDEX (G_TYPE_INT)] = { value_from_py_int,
+                                             value_to_py_int },
+        [FUNDAMENTAL_INDEX (G_TYPE_UINT)] = { value_from_py_uint,
+                                              value_to_py_uint },
+        [FUNDAMENTAL_INDEX (G_TYPE_LONG)] = { value_from_py_long,
+                                              value_to_py_long },
+        [FUNDAMENTAL_INDEX (G_TYPE_ULONG)] = { value_from_py_ulong,
+                                               value_to_py_ulong },
+        [FUNDAMENTAL_INDEX (G_TYPE_INT64)] = { value_from_py_int64,
+                                               value_to_py_int64 },
+        [FUNDAMENTAL_INDEX (G_TYPE_UINT64)] = { value_from_py_uint64,
+                                                value_to_py_uint64 },
+        [FUNDAMENTAL_INDEX (G_TYPE_ENUM)] = { value_from_py_enum,
+                                              value_to_py_enum },
+        [FUNDAMENTAL_INDEX (G_TYPE_FLAGS)] = { value_from_py_flags,
+                                               value_to_py_flags },
+        [FUNDAMENTAL_INDEX (G_TYPE_FLOAT)] = { value_from_py_float,
+                                               value_to_py_float },
+        [FUNDAMENTAL_INDEX (G_TYPE_DOUBLE)] = { value_from_py_double,
+                                                value_to_py_double },
+        [FUNDAMENTAL_INDEX (G_TYPE_STRING)] = { value_from_py_string,
+                                                value_to_py_string },
+        [FUNDAMENTAL_INDEX (G_TYPE_POINTER)] = { value_from_py_pointer,
+                                                 value_to_py_pointer },
+        [FUNDAMENTAL_INDEX (G_TYPE_OBJECT)] = { value_from_py_object,
+                                                value_to_py_object },
+        [FUNDAMENTAL_INDEX (G_TYPE_VARIANT)] = { value_from_py_variant,
+                                                 value_to_py_variant },
+};
+
+static const PyGIValueConverter fundamental_converter = {
+    value_from_py_fundamental,
+    value_to_py_fundamental,
+};
+
+static const PyGIValueConverter interface_object_converter = {
+    value_from_py_interface_object,
+    value_to_py_interface_object,
+};
+
+static const PyGIValueConverter interface_unsupported_converter = {
+    value_from_py_interface_unsupported,
+    value_to_py_interface_unsupported,
+};
+
+static const PyGIValueConverter boxed_pyobject_converter = {
+    value_from_py_boxed_pyobject,
+    value_to_py_boxed_pyobject,
+};
+
+static const PyGIValueConverter boxed_value_converter = {
+    value_from_py_boxed_value,
+    value_to_py_boxed_value,
+};
+
+static const PyGIValueConverter boxed_value_array_converter = {
+    value_from_py_boxed_value_array,
+    value_to_py_boxed_value_array,
+};
+
+static const PyGIValueConverter boxed_array_converter = {
+    value_from_py_boxed_array,
+    value_to_py_boxed,
+};
+
+static const PyGIValueConverter boxed_gstring_converter = {
+    value_from_py_boxed_gstring,
+    value_to_py_boxed_gstring,
+};
+
+static const PyGIValueConverter boxed_converter = {
+    value_from_py_boxed,
+    value_to_py_boxed,
+};
+
+static const PyGIValueConverter *
+value_converter_resolve (GType type)
+{
+    gboolean is_value_array;
+
+    if (G_TYPE_FUNDAMENTAL (type) == G_TYPE_INTERFACE) {
+        /* we only handle interface types that have a GObject prereq */
+        if (g_type_is_a (type, G_TYPE_OBJECT))
+            return &interface_object_converter;
+        else
+            return &interface_unsupported_converter;
+    }
+
+    G_GNUC_BEGIN_IGNORE_DEPRECATIONS
+    is_value_array = g_type_is_a (type, PYGI_TYPE_VALUE_ARRAY);
+    G_GNUC_END_IGNORE_DEPRECATIONS
+
+    if (g_type_is_a (type, PY_TYPE_OBJECT))
+        return &boxed_pyobject_converter;
+    else if (g_type_is_a (type, G_TYPE_VALUE))
+        return &boxed_value_converter;
+    else if (is_value_array)
+        return &boxed_value_array_converter;
+    else if (g_type_is_a (type, G_TYPE_ARRAY))
+        return &boxed_array_converter;
+    else if (g_type_is_a (type, G_TYPE_GSTRING))
+        return &boxed_gstring_converter;
+    else
+        return &boxed_converter;
+}
+
+static const PyGIValueConverter *
+value_converter_lookup (GType type)
+{
+    GType fundamental = G_TYPE_FUNDAMENTAL (type);
+    const PyGIValueConverter *converter;
+
+    if (fundamental != G_TYPE_BOXED && fundamental != G_TYPE_INTERFACE) {
+        converter = &fundamental_converters[FUNDAMENTAL_INDEX (fundamental)];
+        return converter->from_py ? converter : &fundamental_converter;
+    }
+
+    /* The conversion of boxed and interface types depends on the type
+     * itself, cache it next to the custom marshallers in the type's qdata */
+    if (G_UNLIKELY (!pygi_value_converter_key))
+        pygi_value_converter_key =
+            g_quark_from_static_string ("PyGValue::converter");
+
+    converter = g_type_get_qdata (type, pygi_value_converter_key);
+    if (G_UNLIKELY (converter == NULL)) {
+        converter = value_converter_resolve (type);
+        g_type_set_qdata (type, pygi_value_converter_key,
+                          (gpointer)converter);
+    }
+
+    return converter;
+}
+
+#undef FUNDAMENTAL_INDEX
+
+/**
+ * pyg_value_from_pyobject_with_error:
+ * @value: the GValue object to store the converted value in.
+ * @obj: the Python object to convert.
+ *
+ * This function converts a Python object and stores the result in a
+ * GValue.  The GValue must be initialised in advance with
+ * g_value_init().  If the Python object can't be converted to the
+ * type of the GValue, then an error is returned.
+ *
+ * Returns: 0 on success, -1 on error.
+ */
+int
+pyg_value_from_pyobject_with_error (GValue *value, PyObject *obj)
+{
+    const PyGIValueConverter *converter;
+
+    converter = value_converter_lookup (G_VALUE_TYPE (value));
+    return converter->from_py (value, obj);
 }
 
 /**
@@ -697,130 +1230,6 @@ pygi_value_to_py_basic_type (const GValue *value, GType fundamental)
     }
 }
 
-/**
- * value_to_py_structured_type:
- * @value: the GValue object.
- * @copy_boxed: true if boxed values should be copied.
- *
- * This function creates/returns a Python wrapper object that
- * represents the GValue passed as an argument.
- *
- * Returns: a PyObject representing the value or NULL and sets an error;
- */
-static PyObject *
-value_to_py_structured_type (const GValue *value, GType fundamental,
-                             gboolean copy_boxed)
-{
-    const gchar *type_name;
-
-    switch (fundamental) {
-    case G_TYPE_INTERFACE:
-        if (g_type_is_a (G_VALUE_TYPE (value), G_TYPE_OBJECT))
-            return pygobject_new (g_value_get_object (value));
-        else
-            break;
-
-    case G_TYPE_POINTER:
-        if (G_VALUE_HOLDS_GTYPE (value))
-            return pyg_type_wrapper_new (g_value_get_gtype (value));
-        else
-            return pyg_pointer_new (G_VALUE_TYPE (value),
-                                    g_value_get_pointer (value));
-    case G_TYPE_BOXED: {
-        PyGTypeMarshal *bm;
-        gboolean holds_value_array;
-
-        G_GNUC_BEGIN_IGNORE_DEPRECATIONS
-        holds_value_array = G_VALUE_HOLDS (value, PYGI_TYPE_VALUE_ARRAY);
-        G_GNUC_END_IGNORE_DEPRECATIONS
-
-        if (G_VALUE_HOLDS (value, PY_TYPE_OBJECT)) {
-            PyObject *ret = (PyObject *)g_value_dup_boxed (value);
-            if (ret == NULL) {
-                Py_RETURN_NONE;
-            }
-            return ret;
-        } else if (G_VALUE_HOLDS (value, G_TYPE_VALUE)) {
-            GValue *n_value = g_value_get_boxed (value);
-            return pyg_value_to_pyobject (n_value, copy_boxed);
-        } else if (holds_value_array) {
-            GValueArray *array = (GValueArray *)g_value_get_boxed (value);
-            Py_ssize_t n_values = array ? array->n_values : 0;
-            PyObject *ret = PyList_New (n_values);
-            int i;
-            for (i = 0; i < n_values; ++i)
-                PyList_SET_ITEM (
-                    ret, i,
-                    pyg_value_to_pyobject (array->values + i, copy_boxed));
-            return ret;
-        } else if (G_VALUE_HOLDS (value, G_TYPE_GSTRING)) {
-            GString *string = (GString *)g_value_get_boxed (value);
-            PyObject *ret =
-                PyUnicode_FromStringAndSize (string->str, string->len);
-            return ret;
-        }
-        bm = pyg_type_lookup (G_VALUE_TYPE (value));
-        if (bm) {
-            return bm->fromvalue (value);
-        } else {
-            if (copy_boxed)
-                return pygi_gboxed_new (G_VALUE_TYPE (value),
-                                        g_value_get_boxed (value), TRUE, TRUE);
-            else
-                return pygi_gboxed_new (G_VALUE_TYPE (value),
-                                        g_value_get_boxed (value), FALSE,
-                                        FALSE);
-        }
-    }
-    case G_TYPE_OBJECT:
-        return pygobject_new (g_value_get_object (value));
-    case G_TYPE_VARIANT: {
-        GVariant *v = g_value_get_variant (value);
-        if (v == NULL) {
-            Py_RETURN_NONE;
-        }
-        return pygi_struct_new_from_g_type (G_TYPE_VARIANT, g_variant_ref (v),
-                                            FALSE);
-    }
-    case G_TYPE_INVALID:
-        PyErr_SetString (PyExc_TypeError, "Invalid type");
-        return NULL;
-    default: {
-        PyGTypeMarshal *bm;
-        GIRepository *repository;
-        GIBaseInfo *info;
-        GIObjectInfoGetValueFunction get_value_func = NULL;
-
-        if ((bm = pyg_type_lookup (G_VALUE_TYPE (value))))
-            return bm->fromvalue (value);
-
-        repository = pygi_repository_get_default ();
-        info = gi_repository_find_by_gtype (repository, fundamental);
-
-        if (info == NULL) break;
-
-        if (GI_IS_OBJECT_INFO (info))
-            get_value_func = gi_object_info_get_get_value_function_pointer (
-                (GIObjectInfo *)info);
-
-        gi_base_info_unref (info);
-
-        if (get_value_func)
-            return pygi_fundamental_new (get_value_func (value));
-
-        break;
-    }
-    }
-
-    type_name = g_type_name (G_VALUE_TYPE (value));
-    if (type_name == NULL) {
-        type_name = "(null)";
-    }
-    PyErr_Format (PyExc_TypeError, "unknown type %s", type_name);
-    return NULL;
-}
-
-
 /**
  * pyg_value_to_pyobject:
  * @value: the GValue object.
@@ -834,26 +1243,10 @@ value_to_py_structured_type (const GValue *value, GType fundamental,
 PyObject *
 pyg_value_to_pyobject (const GValue *value, gboolean copy_boxed)
 {
-    PyObject *pyobj;
-    GType fundamental = G_TYPE_FUNDAMENTAL (G_VALUE_TYPE (value));
-
-    /* HACK: special case char and uchar to return PyBytes intstead of integers
-     * in the general case. Property access will skip this by calling
-     * pygi_value_to_py_basic_type() directly.
-     * See: https://bugzilla.gnome.org/show_bug.cgi?id=733893 */
-    if (fundamental == G_TYPE_CHAR) {
-        gint8 val = g_value_get_schar (value);
-        return PyUnicode_FromStringAndSize ((char *)&val, 1);
-    } else if (fundamental == G_TYPE_UCHAR) {
-        guint8 val = g_value_get_uchar (value);
-        return PyBytes_FromStringAndSize ((char *)&val, 1);
-    }
-
-    pyobj = pygi_value_to_py_basic_type (value, fundamental);
-    if (pyobj != NULL || PyErr_Occurred ()) return pyobj;
+    const PyGIValueConverter *converter;
 
-    pyobj = value_to_py_structured_type (value, fundamental, copy_boxed);
-    return pyobj;
+    converter = value_converter_lookup (G_VALUE_TYPE (value));
+    return converter->to_py (value, copy_boxed);
 }
 
 
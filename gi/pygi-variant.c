@@ -0,0 +1,409 @@
+/* -*- Mode: C; c-basic-offset: 4 -*-
+ * vim: tabstop=4 shiftwidth=4 expandtab
+ *
+ *   pygi-variant.c: converting between GVariant and Python values
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pygi-variant.h"
+
+#include "pygi-basictype.h"
+#include "pygi-struct.h"
+#include "pygi-type.h"
+#include "pygpointer.h"
+
+/* These follow GLib.Variant() and GLib.Variant.unpack() in the GLib
+ * overrides, without creating intermediate GLib.Variant wrappers. */
+
+static GITypeTag
+variant_basic_type_tag (const GVariantType *type)
+{
+    switch (g_variant_type_peek_string (type)[0]) {
+    case 'b':
+        return GI_TYPE_TAG_BOOLEAN;
+    case 'y':
+        return GI_TYPE_TAG_UINT8;
+    case 'n':
+        return GI_TYPE_TAG_INT16;
+    case 'q':
+        return GI_TYPE_TAG_UINT16;
+    case 'i':
+    case 'h':
+        return GI_TYPE_TAG_INT32;
+    case 'u':
+        return GI_TYPE_TAG_UINT32;
+    case 'x':
+        return GI_TYPE_TAG_INT64;
+    case 't':
+        return GI_TYPE_TAG_UINT64;
+    case 'd':
+        return GI_TYPE_TAG_DOUBLE;
+    case 's':
+    case 'o':
+    case 'g':
+        return GI_TYPE_TAG_UTF8;
+    default:
+        return GI_TYPE_TAG_VOID;
+    }
+}
+
+static GVariant *
+variant_basic_from_py (const GVariantType *type, PyObject *value)
+{
+    GITypeTag type_tag = variant_basic_type_tag (type);
+    gpointer cleanup_data = NULL;
+    GVariant *variant = NULL;
+    GIArgument arg;
+
+    if (type_tag == GI_TYPE_TAG_UTF8 && Py_IsNone (value)) {
+        PyErr_SetString (PyExc_TypeError, "Must be string, not NoneType");
+        return NULL;
+    }
+
+    arg = pygi_marshal_from_py_basic_type (value, type_tag,
+                                           GI_TRANSFER_NOTHING, &cleanup_data);
+    if (PyErr_Occurred ()) return NULL;
+
+    switch (g_variant_type_peek_string (type)[0]) {
+    case 'b':
+        variant = g_variant_new_boolean (arg.v_boolean);
+        break;
+    case 'y':
+        variant = g_variant_new_byte (arg.v_uint8);
+        break;
+    case 'n':
+        variant = g_variant_new_int16 (arg.v_int16);
+        break;
+    case 'q':
+        variant = g_variant_new_uint16 (arg.v_uint16);
+        break;
+    case 'i':
+        variant = g_variant_new_int32 (arg.v_int32);
+        break;
+    case 'h':
+        variant = g_variant_new_handle (arg.v_int32);
+        break;
+    case 'u':
+        variant = g_variant_new_uint32 (arg.v_uint32);
+        break;
+    case 'x':
+        variant = g_variant_new_int64 (arg.v_int64);
+        break;
+    case 't':
+        variant = g_variant_new_uint64 (arg.v_uint64);
+        break;
+    case 'd':
+        variant = g_variant_new_double (arg.v_double);
+        break;
+    case 's':
+        variant = g_variant_new_string (arg.v_string);
+        break;
+    case 'o':
+        if (g_variant_is_object_path (arg.v_string))
+            variant = g_variant_new_object_path (arg.v_string);
+        else
+            PyErr_Format (PyExc_TypeError, "'%s' is not a valid object path",
+                          arg.v_string);
+        break;
+    case 'g':
+        if (g_variant_is_signature (arg.v_string))
+            variant = g_variant_new_signature (arg.v_string);
+        else
+            PyErr_Format (PyExc_TypeError, "'%s' is not a valid signature",
+                          arg.v_string);
+        break;
+    default:
+        g_assert_not_reached ();
+    }
+
+    g_free (cleanup_data);
+
+    return variant;
+}
+
+static void
+variant_type_error (const GVariantType *type, PyObject *value,
+                    const char *message)
+{
+    gchar *type_string = g_variant_type_dup_string (type);
+
+    PyErr_Format (PyExc_TypeError, "%s %s %R", message, type_string, value);
+    g_free (type_string);
+}
+
+/**
+ * pygi_variant_from_py:
+ * @type: a definite GVariant type
+ * @value: the Python value
+ *
+ * Returns: (transfer floating): a new GVariant, or %NULL with an exception
+ * set.
+ */
+GVariant *
+pygi_variant_from_py (const GVariantType *type, PyObject *value)
+{
+    GVariantBuilder builder;
+    const GVariantType *item_type = NULL;
+    PyObject *items, *iter, *item;
+    gboolean ok = TRUE;
+
+    if (g_variant_type_is_basic (type))
+        return variant_basic_from_py (type, value);
+
+    if (g_variant_type_is_variant (type)) {
+        if (pyg_type_from_object_strict (value, FALSE) != G_TYPE_VARIANT) {
+            PyErr_Format (PyExc_TypeError, "Expected Variant, not %s",
+                          Py_TYPE (value)->tp_name);
+            return NULL;
+        }
+        return g_variant_new_variant (pyg_pointer_get (value, GVariant));
+    }
+
+    g_variant_builder_init (&builder, type);
+
+    if (Py_IsNone (value)
+        && (g_variant_type_is_array (type) || g_variant_type_is_maybe (type)))
+        return g_variant_builder_end (&builder);
+
+    if (g_variant_type_is_maybe (type)) {
+        GVariant *child;
+
+        child = pygi_variant_from_py (g_variant_type_element (type), value);
+        if (child == NULL) {
+            g_variant_builder_clear (&builder);
+            return NULL;
+        }
+        g_variant_builder_add_value (&builder, child);
+        return g_variant_builder_end (&builder);
+    }
+
+    if (g_variant_type_is_array (type)) {
+        item_type = g_variant_type_element (type);
+        if (PyDict_Check (value))
+            items = PyDict_Items (value);
+        else
+            items = Py_NewRef (value);
+    } else {
+        Py_ssize_t length = PyObject_Length (value);
+
+        if (length < 0) {
+            variant_type_error (type, value,
+                                "Could not create array, tuple or dictionary "
+                                "entry from non iterable value");
+            g_variant_builder_clear (&builder);
+            return NULL;
+        }
+
+        if ((gsize)length != g_variant_type_n_items (type)) {
+            variant_type_error (type, value,
+                                g_variant_type_is_tuple (type)
+                                    ? "Tuple mismatches value's number of "
+                                      "elements"
+                                    : "Dictionary entries must have two "
+                                      "elements");
+            g_variant_builder_clear (&builder);
+            return NULL;
+        }
+
+        item_type = g_variant_type_first (type);
+        items = Py_NewRef (value);
+    }
+
+    if (items == NULL) {
+        g_variant_builder_clear (&builder);
+        return NULL;
+    }
+
+    iter = PyObject_GetIter (items);
+    Py_DECREF (items);
+    if (iter == NULL) {
+        variant_type_error (type, value,
+                            "Could not create array, tuple or dictionary "
+                            "entry from non iterable value");
+        g_variant_builder_clear (&builder);
+        return NULL;
+    }
+
+    while (ok && (item = PyIter_Next (iter)) != NULL) {
+        GVariant *child = pygi_variant_from_py (item_type, item);
+
+        Py_DECREF (item);
+        if (child == NULL) {
+            ok = FALSE;
+        } else {
+            g_variant_builder_add_value (&builder, child);
+            if (!g_variant_type_is_array (type))
+                item_type = g_variant_type_next (item_type);
+        }
+    }
+    Py_DECREF (iter);
+
+    if (!ok || PyErr_Occurred ()) {
+        g_variant_builder_clear (&builder);
+        return NULL;
+    }
+
+    return g_variant_builder_end (&builder);
+}
+
+/**
+ * pygi_variant_to_py:
+ * @variant: a GVariant
+ *
+ * Like GLib.Variant.unpack(): tuples become tuples, dicts become dicts,
+ * other arrays become lists, variants are unboxed and maybes become the
+ * value or None.
+ *
+ * Returns: a new reference, or %NULL with an exception set.
+ */
+PyObject *
+pygi_variant_to_py (GVariant *variant)
+{
+    const GVariantType *type = g_variant_get_type (variant);
+    PyObject *result, *item;
+    gsize i, n_children;
+
+    switch (g_variant_classify (variant)) {
+    case G_VARIANT_CLASS_BOOLEAN:
+        return PyBool_FromLong (g_variant_get_boolean (variant));
+    case G_VARIANT_CLASS_BYTE:
+        return PyLong_FromLong (g_variant_get_byte (variant));
+    case G_VARIANT_CLASS_INT16:
+        return PyLong_FromLong (g_variant_get_int16 (variant));
+    case G_VARIANT_CLASS_UINT16:
+        return PyLong_FromLong (g_variant_get_uint16 (variant));
+    case G_VARIANT_CLASS_INT32:
+        return PyLong_FromLong (g_variant_get_int32 (variant));
+    case G_VARIANT_CLASS_HANDLE:
+        return PyLong_FromLong (g_variant_get_handle (variant));
+    case G_VARIANT_CLASS_UINT32:
+        return PyLong_FromUnsignedLong (g_variant_get_uint32 (variant));
+    case G_VARIANT_CLASS_INT64:
+        return PyLong_FromLongLong (g_variant_get_int64 (variant));
+    case G_VARIANT_CLASS_UINT64:
+        return PyLong_FromUnsignedLongLong (g_variant_get_uint64 (variant));
+    case G_VARIANT_CLASS_DOUBLE:
+        return PyFloat_FromDouble (g_variant_get_double (variant));
+    case G_VARIANT_CLASS_STRING:
+    case G_VARIANT_CLASS_OBJECT_PATH:
+    case G_VARIANT_CLASS_SIGNATURE:
+        return PyUnicode_FromString (g_variant_get_string (variant, NULL));
+    case G_VARIANT_CLASS_VARIANT: {
+        GVariant *child = g_variant_get_variant (variant);
+
+        result = pygi_variant_to_py (child);
+        g_variant_unref (child);
+        return result;
+    }
+    case G_VARIANT_CLASS_MAYBE: {
+        GVariant *child = g_variant_get_maybe (variant);
+
+        if (child == NULL) Py_RETURN_NONE;
+        result = pygi_variant_to_py (child);
+        g_variant_unref (child);
+        return result;
+    }
+    case G_VARIANT_CLASS_ARRAY:
+    case G_VARIANT_CLASS_TUPLE:
+    case G_VARIANT_CLASS_DICT_ENTRY:
+    default:
+        /* Containers, unpacked below */
+        break;
+    }
+
+    n_children = g_variant_n_children (variant);
+
+    if (g_variant_type_is_tuple (type) || g_variant_type_is_dict_entry (type))
+        result = PyTuple_New ((Py_ssize_t)n_children);
+    else if (g_variant_type_is_dict_entry (g_variant_type_element (type)))
+        result = PyDict_New ();
+    else
+        result = PyList_New ((Py_ssize_t)n_children);
+    if (result == NULL) return NULL;
+
+    for (i = 0; i < n_children; i++) {
+        GVariant *child = g_variant_get_child_value (variant, i);
+
+        if (PyDict_Check (result)) {
+            GVariant *key = g_variant_get_child_value (child, 0);
+            GVariant *value = g_variant_get_child_value (child, 1);
+            PyObject *py_key = pygi_variant_to_py (key);
+            PyObject *py_value = py_key ? pygi_variant_to_py (value) : NULL;
+
+            g_variant_unref (key);
+            g_variant_unref (value);
+            if (py_value == NULL
+                || PyDict_SetItem (result, py_key, py_value) < 0)
+                item = NULL;
+            else
+                item = Py_None;
+            Py_XDECREF (py_key);
+            Py_XDECREF (py_value);
+        } else {
+            item = pygi_variant_to_py (child);
+            if (item != NULL && PyTuple_Check (result))
+                PyTuple_SET_ITEM (result, (Py_ssize_t)i, item);
+            else if (item != NULL)
+                PyList_SET_ITEM (result, (Py_ssize_t)i, item);
+        }
+        g_variant_unref (child);
+
+        if (item == NULL) {
+            Py_DECREF (result);
+            return NULL;
+        }
+    }
+
+    return result;
+}
+
+PyObject *
+pygi_variant_new (PyObject *self, PyObject *args)
+{
+    const char *type_string;
+    PyObject *value;
+    GVariantType *type;
+    GVariant *variant;
+
+    if (!PyArg_ParseTuple (args, "sO:variant_new", &type_string, &value))
+        return NULL;
+
+    if (!g_variant_type_string_is_valid (type_string)
+        || !g_variant_type_is_definite ((const GVariantType *)type_string)) {
+        PyErr_Format (PyExc_TypeError, "Invalid GVariant format string '%s'",
+                      type_string);
+        return NULL;
+    }
+
+    type = g_variant_type_new (type_string);
+    variant = pygi_variant_from_py (type, value);
+    g_variant_type_free (type);
+    if (variant == NULL) return NULL;
+
+    return pygi_struct_new_from_g_type (G_TYPE_VARIANT,
+                                        g_variant_ref_sink (variant), FALSE);
+}
+
+PyObject *
+pygi_variant_unpack (PyObject *self, PyObject *py_variant)
+{
+    if (pyg_type_from_object_strict (py_variant, FALSE) != G_TYPE_VARIANT) {
+        PyErr_Format (PyExc_TypeError, "Expected Variant, not %s",
+                      Py_TYPE (py_variant)->tp_name);
+        return NULL;
+    }
+
+    return pygi_variant_to_py (pyg_pointer_get (py_variant, GVariant));
+}
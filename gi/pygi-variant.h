@@ -0,0 +1,33 @@
+/* -*- Mode: C; c-basic-offset: 4 -*-
+ * vim: tabstop=4 shiftwidth=4 expandtab
+ *
+ *   pygi-variant.h: converting between GVariant and Python values
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <glib.h>
+#include <pythoncapi_compat.h>
+
+G_BEGIN_DECLS
+
+GVariant *pygi_variant_from_py (const GVariantType *type, PyObject *value);
+PyObject *pygi_variant_to_py (GVariant *variant);
+
+PyObject *pygi_variant_new (PyObject *self, PyObject *args);
+PyObject *pygi_variant_unpack (PyObject *self, PyObject *py_variant);
+
+G_END_DECLS
@@ -49,6 +49,69 @@ pygobject_init_wrapper_get (void)
     return (PyObject *)g_private_get (&pygobject_construction_wrapper);
 }
 
+/* Which Python hooks instance_init and constructed have to call for
+ * instances of a Python class. Plans are cached by class and recomputed when
+ * the type's version tag changes, which CPython does whenever the class or
+ * one of its bases is modified. */
+typedef struct {
+    unsigned int version_tag;
+    guint has_template_init : 1;
+    guint has_do_constructed : 1;
+    guint has_init : 1;
+} PyGObjectConstructPlan;
+
+/* PyTypeObject * -> PyGObjectConstructPlan, only used with the GIL held */
+static GHashTable *construct_plans;
+static PyObject *base_do_constructed;
+
+#ifdef PYPY_VERSION
+#define PYGOBJECT_TYPE_VERSION(type) 0
+#else
+#define PYGOBJECT_TYPE_VERSION(type) ((type)->tp_version_tag)
+#endif
+
+static const PyGObjectConstructPlan *
+pygobject_construct_plan_get (PyTypeObject *type)
+{
+    PyGObjectConstructPlan *plan;
+    PyObject *do_constructed;
+
+    if (construct_plans == NULL) {
+        construct_plans = g_hash_table_new_full (NULL, NULL, NULL, g_free);
+        base_do_constructed = PyObject_GetAttrString (
+            (PyObject *)&PyGObject_Type, "do_constructed");
+        g_assert (base_do_constructed != NULL);
+    }
+
+    plan = g_hash_table_lookup (construct_plans, type);
+    if (plan == NULL) {
+        plan = g_new0 (PyGObjectConstructPlan, 1);
+        g_hash_table_insert (construct_plans, type, plan);
+    } else if (plan->version_tag != 0
+               && plan->version_tag == PYGOBJECT_TYPE_VERSION (type)) {
+        return plan;
+    }
+
+    plan->has_template_init = PyObject_HasAttrString (
+        (PyObject *)type, "__dontuse_ginstance_init__");
+
+    /* The GObject.Object implementation does nothing. */
+    do_constructed =
+        PyObject_GetAttrString ((PyObject *)type, "do_constructed");
+    if (do_constructed == NULL) PyErr_Clear ();
+    plan->has_do_constructed =
+        do_constructed != NULL && do_constructed != base_do_constructed;
+    Py_XDECREF (do_constructed);
+
+    /* GObject.Object.__init__() returns right away if the GObject exists. */
+    plan->has_init = type->tp_init != PyGObject_Type.tp_init;
+
+    /* Looking up the attributes above assigned a version tag if possible. */
+    plan->version_tag = PYGOBJECT_TYPE_VERSION (type);
+
+    return plan;
+}
+
 typedef struct _PyGSignalAccumulatorData {
     PyObject *callable;
     PyObject *user_data;
@@ -708,7 +771,8 @@ pyg_object_constructed (GObject *object)
     g_assert (wrapper != NULL);
 
     if (!PyErr_Occurred ()
-        && PyObject_HasAttrString (wrapper, "do_constructed")) {
+        && pygobject_construct_plan_get (Py_TYPE (wrapper))
+               ->has_do_constructed) {
         retval = PyObject_CallMethod (wrapper, "do_constructed", NULL);
         Py_XDECREF (retval);
     }
@@ -735,6 +799,7 @@ pygobject__g_instance_init (GTypeInstance *instance, gpointer g_class)
     GObject *object;
     PyObject *wrapper, *result;
     PyGILState_STATE state;
+    const PyGObjectConstructPlan *plan;
     gboolean needs_init = FALSE;
 
     g_return_if_fail (G_IS_OBJECT (instance));
@@ -762,12 +827,12 @@ pygobject__g_instance_init (GTypeInstance *instance, gpointer g_class)
         needs_init = TRUE;
     }
 
+    plan = pygobject_construct_plan_get (Py_TYPE (wrapper));
+
     /* XXX: used for Gtk.Template */
     gboolean is_final_subclass = G_OBJECT_TYPE (object)
                                  == G_OBJECT_CLASS_TYPE (g_class);
-    if (is_final_subclass
-        && PyObject_HasAttrString ((PyObject *)Py_TYPE (wrapper),
-                                   "__dontuse_ginstance_init__")) {
+    if (is_final_subclass && plan->has_template_init) {
         gboolean was_floating = g_object_is_floating (object);
         g_object_ref_sink (object);
 
@@ -785,11 +850,13 @@ pygobject__g_instance_init (GTypeInstance *instance, gpointer g_class)
     }
 
     if (needs_init) {
-        result = PyObject_CallMethod (wrapper, "__init__", NULL);
-        if (result == NULL)
-            PyErr_Print ();
-        else
-            Py_DECREF (result);
+        if (plan->has_init) {
+            result = PyObject_CallMethod (wrapper, "__init__", NULL);
+            if (result == NULL)
+                PyErr_Print ();
+            else
+                Py_DECREF (result);
+        }
 
         /* The wrapper's reference will be released in pyg_object_constructed(). */
         g_object_set_qdata (object, pygobject_instance_init_ref_count,
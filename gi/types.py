@@ -24,6 +24,7 @@ from ._constants import TYPE_INVALID
 from .docstring import generate_doc_string
 
 from ._gi import (
+    FieldDescriptor,
     InterfaceInfo,
     ObjectInfo,
     StructInfo,
@@ -46,6 +47,39 @@ def snake_case(name):
     return re.sub(r"([a-z0-9])([A-Z])", r"\1_\2", s1).lower()
 
 
+# GI class -> (prefix, {vfunc name: VFuncInfo}) for the vfuncs of the
+# __info__ the class defines, see _vfunc_index()
+_vfunc_indices = {}
+
+
+def _vfunc_index(klass):
+    """Returns the vfuncs of klass.__info__ as ("do_<type name>_" prefix,
+    {vfunc name: VFuncInfo}), or None if klass has no vfuncs.
+
+    The index is built once per class defining the __info__, so looking up a
+    vfunc doesn't have to call get_vfuncs() on every class in the hierarchy.
+    """
+    for owner in klass.__mro__:
+        if "__info__" in owner.__dict__:
+            break
+    else:
+        return None
+
+    try:
+        return _vfunc_indices[owner]
+    except KeyError:
+        pass
+
+    info = owner.__dict__["__info__"]
+    if hasattr(info, "get_vfuncs"):
+        prefix = f"do_{snake_case(info.get_type_name())}_"
+        index = (prefix, {v.get_name(): v for v in info.get_vfuncs()})
+    else:
+        index = None
+    _vfunc_indices[owner] = index
+    return index
+
+
 class MetaClassHelper:
     def _setup_methods(cls):
         for method_info in cls.__info__.get_methods():
@@ -70,7 +104,7 @@ class MetaClassHelper:
     def _setup_fields(cls):
         for field_info in cls.__info__.get_fields():
             name = field_info.get_name().replace("-", "_")
-            setattr(cls, name, property(field_info.get_value, field_info.set_value))
+            setattr(cls, name, FieldDescriptor(field_info, cls))
 
     def _setup_constants(cls):
         for constant_info in cls.__info__.get_constants():
@@ -97,22 +131,17 @@ class MetaClassHelper:
                     vfunc_info = method
                     break
 
-                if not hasattr(base, "__info__") or not hasattr(
-                    base.__info__, "get_vfuncs"
-                ):
+                index = _vfunc_index(base)
+                if index is None:
                     continue
 
-                base_name = snake_case(base.__info__.get_type_name())
-
-                for v in base.__info__.get_vfuncs():
-                    if vfunc_name == f"do_{base_name}_{v.get_name()}":
-                        vfunc_info = v
+                prefix, vfuncs = index
+                if vfunc_name.startswith(prefix):
+                    vfunc_info = vfuncs.get(vfunc_name[len(prefix) :])
+                    if vfunc_info is not None:
                         skip_ambiguity_check = True
                         break
 
-                if vfunc_info:
-                    break
-
             # If we did not find a matching method name in the bases, we might
             # be overriding an interface virtual method. Since interfaces do not
             # provide implementations, there will be no method attribute installed
@@ -174,9 +203,9 @@ def find_vfunc_info_in_interface(bases, vfunc_name):
 
         # Only look at this classes vfuncs if it is an interface.
         if isinstance(base.__info__, InterfaceInfo):
-            for vfunc in base.__info__.get_vfuncs():
-                if vfunc.get_name() == vfunc_name:
-                    return vfunc
+            vfunc = _vfunc_index(base)[1].get(vfunc_name)
+            if vfunc is not None:
+                return vfunc
 
         # Recurse into the parent classes
         vfunc = find_vfunc_info_in_interface(base.__bases__, vfunc_name)
@@ -187,14 +216,14 @@ def find_vfunc_info_in_interface(bases, vfunc_name):
 
 
 def find_vfunc_conflict_in_bases(vfunc, bases):
+    vfunc_name = vfunc.get_name()
     for klass in bases:
-        if not hasattr(klass, "__info__") or not hasattr(klass.__info__, "get_vfuncs"):
+        index = _vfunc_index(klass)
+        if index is None:
             continue
-        vfuncs = klass.__info__.get_vfuncs()
-        vfunc_name = vfunc.get_name()
-        for v in vfuncs:
-            if v.get_name() == vfunc_name and v != vfunc:
-                return klass
+        v = index[1].get(vfunc_name)
+        if v is not None and v != vfunc:
+            return klass
 
         aklass = find_vfunc_conflict_in_bases(vfunc, klass.__bases__)
         if aklass is not None:
@@ -1,3 +1,4 @@
+import os
 import sys
 import types
 import pytest
@@ -10,6 +11,13 @@ from gi._gi import Async
 from gi.repository import GLib, Gio
 from gi.events import GLibEventLoopPolicy
 
+try:
+    from gi.repository import GioUnix
+
+    UnixInputStream = GioUnix.InputStream
+except (ImportError, AttributeError):
+    UnixInputStream = getattr(Gio, "UnixInputStream", None)
+
 
 class TestAsync(unittest.TestCase):
     def setUp(self):
@@ -283,6 +291,150 @@ class TestAsync(unittest.TestCase):
 
         self.loop.run_until_complete(run())
 
+    def test_async_many(self):
+        f = Gio.file_new_for_path("./")
+
+        async def run():
+            for i in range(100):
+                res = f.enumerate_children_async(
+                    "standard::*", 0, GLib.PRIORITY_DEFAULT
+                )
+                self.assertFalse(res.done())
+                if i % 2:
+                    res.cancel()
+                    with self.assertRaises(GLib.GError):
+                        await res
+                    self.assertIsInstance(res.exception(), GLib.GError)
+                else:
+                    self.assertIsNotNone(await res)
+                    self.assertIsNone(res.exception())
+                del res
+
+        self.loop.run_until_complete(run())
+
+    def test_run_in_pool(self):
+        f, stream = Gio.File.new_tmp("pygobject.XXXXXX")
+        self.addCleanup(f.delete)
+        stream.get_output_stream().write_bytes(GLib.Bytes(b"content"))
+        stream.close()
+        missing = Gio.File.new_for_path(f.get_path() + ".missing")
+
+        async def run():
+            res = Gio.File.load_contents.run_in_pool(f, None)
+            self.assertFalse(res.done())
+            ok, contents, _etag = await res
+            self.assertTrue(ok)
+            self.assertEqual(contents, b"content")
+
+            results = await asyncio.gather(
+                *(Gio.File.load_contents.run_in_pool(f, None) for i in range(10))
+            )
+            self.assertEqual([r[1] for r in results], [b"content"] * 10)
+
+            with self.assertRaises(GLib.GError):
+                await Gio.File.load_contents.run_in_pool(missing, None)
+
+            with self.assertRaises(TypeError):
+                Gio.File.load_contents.run_in_pool(f, None, "extra")
+
+            with self.assertRaises(TypeError):
+                Gio.File.load_contents_async.run_in_pool(f, 0, None, None)
+
+        self.loop.run_until_complete(run())
+
+        with self.assertRaises(RuntimeError):
+            Gio.File.load_contents.run_in_pool(f, None)
+
+    @unittest.skipIf(UnixInputStream is None, "no unix streams")
+    def test_run_in_pool_cancel(self):
+        read_fd, write_fd = os.pipe()
+        self.addCleanup(os.close, write_fd)
+        stream = UnixInputStream.new(read_fd, True)
+
+        async def run():
+            res = Gio.InputStream.read_bytes.run_in_pool(stream, 10, None)
+            # the pool thread is blocked reading from the empty pipe
+            await asyncio.sleep(0.1)
+            self.assertFalse(res.done())
+            res.cancel()
+            with self.assertRaises(GLib.GError) as context:
+                await res
+            self.assertTrue(
+                context.exception.matches(
+                    Gio.io_error_quark(), Gio.IOErrorEnum.CANCELLED
+                )
+            )
+
+        self.loop.run_until_complete(run())
+
+    def test_stream_iter_chunks(self):
+        data = bytes(range(256)) * 1000
+        stream = Gio.MemoryInputStream.new_from_bytes(GLib.Bytes(data))
+
+        async def run():
+            chunks = [
+                bytes(chunk)
+                async for chunk in stream.iter_chunks(chunk_size=1000, read_ahead=3)
+            ]
+            self.assertEqual(len(chunks), 256)
+            self.assertEqual(b"".join(chunks), data)
+
+        self.loop.run_until_complete(run())
+
+    def test_stream_iter_chunks_break(self):
+        stream = Gio.MemoryInputStream.new_from_bytes(GLib.Bytes(b"x" * 100000))
+
+        async def run():
+            chunks = stream.iter_chunks(chunk_size=10, read_ahead=2)
+            async for chunk in chunks:
+                self.assertEqual(chunk, b"x" * 10)
+                break
+            await chunks.aclose()
+
+        self.loop.run_until_complete(run())
+
+    @unittest.skipIf(UnixInputStream is None, "no unix streams")
+    def test_stream_iter_chunks_cancel_blocked(self):
+        read_fd, write_fd = os.pipe()
+        self.addCleanup(os.close, write_fd)
+        stream = UnixInputStream.new(read_fd, True)
+
+        async def consume():
+            async for chunk in stream.iter_chunks():
+                pass
+
+        async def run():
+            task = asyncio.ensure_future(consume())
+            await asyncio.sleep(0.1)
+            # the worker is blocked reading from the empty pipe
+            self.assertTrue(stream.has_pending())
+            task.cancel()
+            with self.assertRaises(asyncio.CancelledError):
+                await task
+
+            # stopping the pump cancels the read
+            for i in range(100):
+                if not stream.has_pending():
+                    break
+                await asyncio.sleep(0.01)
+            self.assertFalse(stream.has_pending())
+
+        self.loop.run_until_complete(run())
+
+    def test_stream_pump_from(self):
+        data = b"hello world" * 10000
+        source = Gio.MemoryInputStream.new_from_bytes(GLib.Bytes(data))
+        target = Gio.MemoryOutputStream.new_resizable()
+
+        async def run():
+            total = await target.pump_from(source, chunk_size=4096)
+            self.assertEqual(total, len(data))
+            self.assertEqual(await target.pump_from(source), 0)
+
+        self.loop.run_until_complete(run())
+        target.close()
+        self.assertEqual(bytes(target.steal_as_bytes()), data)
+
 
 class TestAsyncGenericAlias(unittest.TestCase):
     def test_subscript_with_typevar_returns_generic_alias(self):
@@ -83,6 +83,15 @@ class EnumTests(unittest.TestCase):
             str(w[0].message), f"cannot register existing type '{type_name}'"
         )
 
+    def test_marshal_returns_member(self):
+        class MyEnum(GObject.GEnum):
+            ONE = 1
+            TWO = 2
+
+        for _ in range(2):
+            value = GObject.Value(MyEnum, MyEnum.TWO)
+            self.assertIs(value.get_value(), MyEnum.TWO)
+
     @unittest.skipUnless(Gtk, "Gtk not available")
     def test_enum_as_string(self):
         box = Gtk.Box(orientation="vertical")
@@ -133,6 +142,20 @@ class FlagsTests(unittest.TestCase):
         self.assertEqual(v.value_names, ["ONE", "THIRTY_TWO"])
         self.assertEqual(v.value_nicks, ["one", "thirty-two"])
 
+    def test_marshal_returns_member(self):
+        class MyFlags(GObject.GFlags):
+            ONE = 1
+            TWO = 2
+
+        value = GObject.Value(MyFlags, MyFlags.TWO)
+        self.assertIs(value.get_value(), MyFlags.TWO)
+
+        value = GObject.Value(MyFlags, MyFlags.ONE | MyFlags.TWO)
+        first = value.get_value()
+        self.assertIsInstance(first, MyFlags)
+        self.assertEqual(first, 3)
+        self.assertEqual(value.get_value(), first)
+
     def test_custom_type_name(self):
         type_name = f"MyFlags{get_id()}"
 
@@ -131,6 +131,20 @@ class TestMarshalling(unittest.TestCase):
         self.assertEqual(e.code, GIMarshallingTests.CONSTANT_GERROR_CODE)
         self.assertEqual(e.message, GIMarshallingTests.CONSTANT_GERROR_MESSAGE)
 
+    def test_exception_from_c(self):
+        errors = []
+        for i in range(2):
+            with self.assertRaises(GLib.Error) as context:
+                GIMarshallingTests.gerror()
+            errors.append(context.exception)
+
+        e = errors[0]
+        self.assertIs(type(e), GLib.Error)
+        self.assertEqual(e.args, (GIMarshallingTests.CONSTANT_GERROR_MESSAGE,))
+        self.assertEqual(pickle.loads(pickle.dumps(e)).domain, e.domain)
+        # the domain string is created once per domain
+        self.assertIs(errors[0].domain, errors[1].domain)
+
     def test_vfunc_no_exception(self):
         obj = ObjectWithVFuncException()
         self.assertTrue(obj.vfunc_meth_with_error(42))
@@ -397,6 +397,87 @@ class GLibEventLoopPolicyTests(unittest.TestCase):
             + [GLib.PRIORITY_DEFAULT_IDLE] * 3,
         )
 
+    def test_glib_task_prio_many(self):
+        """Tasks run by priority, and in order within the same priority."""
+        policy = self.create_policy()
+        loop = policy.new_event_loop()
+
+        priorities = [GLib.PRIORITY_HIGH, 50, GLib.PRIORITY_DEFAULT_IDLE, 150]
+        order = []
+
+        async def run_prio(priority, i):
+            await asyncio.sleep(0)
+            order.append((priority, i))
+
+        async def run():
+            tasks = []
+            for i in range(50):
+                for priority in priorities:
+                    task = asyncio.create_task(run_prio(priority, i))
+                    task.set_priority(priority)
+                    tasks.append(task)
+
+            # Cancelled tasks do not run anymore
+            tasks[0].cancel()
+
+            await asyncio.wait(tasks)
+
+        loop.run_until_complete(run())
+        loop.close()
+
+        self.assertNotIn((GLib.PRIORITY_HIGH, 0), order)
+        self.assertEqual(
+            order,
+            sorted(order, key=lambda x: x[0]),
+        )
+        self.assertEqual(
+            [i for p, i in order if p == 150],
+            list(range(50)),
+        )
+
+    def test_glib_handle_prio_cancel(self):
+        """Cancelled handles queued at a priority are skipped."""
+        policy = self.create_policy()
+        loop = policy.new_event_loop()
+
+        priorities = [GLib.PRIORITY_HIGH, 50, GLib.PRIORITY_DEFAULT_IDLE, 150]
+        order = []
+
+        class Callback:
+            # Picked up by GLibEventLoop.call_soon() through the bound method
+            def __init__(self, priority, func, *args):
+                self._glib_idle_priority = priority
+                self.func = func
+                self.args = args
+
+            def run(self):
+                self.func(*self.args)
+
+        async def run():
+            done = loop.create_future()
+            handles = {}
+            for i in range(10):
+                for priority in priorities:
+                    callback = Callback(priority, order.append, (priority, i))
+                    handles[priority, i] = loop.call_soon(callback.run)
+            # Queued at the lowest priority, so it runs last
+            loop.call_soon(Callback(300, done.set_result, None).run)
+
+            handles[GLib.PRIORITY_HIGH, 0].cancel()
+            handles[150, 5].cancel()
+            await done
+
+        loop.run_until_complete(run())
+        loop.close()
+
+        expected = [
+            (priority, i)
+            for priority in sorted(priorities)
+            for i in range(10)
+            if (priority, i) not in [(GLib.PRIORITY_HIGH, 0), (150, 5)]
+        ]
+        self.assertEqual(order, expected)
+
     @unittest.skipIf(sys.platform == "win32", "add reader/writer not implemented")
     def test_source_fileobj_fd(self):
         """Regression test for
@@ -455,6 +536,90 @@ class GLibEventLoopPolicyTests(unittest.TestCase):
         loop.run_until_complete(run())
         loop.close()
 
+    @unittest.skipIf(sys.platform == "win32", "add reader/writer not implemented")
+    def test_selector_source(self):
+        loop = gi.events.GLibEventLoop(GLib.MainContext())
+        s1, s2 = socket.socketpair()
+        try:
+            # Only returns the ready FDs while the source is dispatching
+            with self.assertRaises(RuntimeError):
+                loop._selector.select()
+
+            ready = []
+            loop.add_reader(s1, lambda: ready.append(s1.recv(1)))
+            loop.call_soon(s2.send, b"x")
+            loop.call_later(0.1, loop.stop)
+            loop.run_forever()
+            self.assertEqual(ready, [b"x"])
+
+            loop.remove_reader(s1)
+            self.assertEqual(len(loop._selector.get_map()), 1)
+        finally:
+            s1.close()
+            s2.close()
+            loop.close()
+
+    @unittest.skipIf(sys.platform == "win32", "add reader/writer not implemented")
+    def test_selector_source_paused_hup(self):
+        """A paused selector source does not wake up a nested iteration, not
+        even for a hung up fd.
+        """
+        loop = gi.events.GLibEventLoop(GLib.MainContext())
+        s1, s2 = socket.socketpair()
+        s2.close()
+        regular = open(__file__, "rb")
+        try:
+            loop.add_reader(s1, lambda: None)
+            loop.add_reader(regular, lambda: None)
+
+            async def nested_iteration():
+                await asyncio.sleep(0)
+                # Prioritized tasks run with the selector source paused
+                context = super(GLib.MainContext, loop._context)
+                self.assertFalse(context.iteration(False))
+
+            async def run():
+                task = asyncio.create_task(nested_iteration())
+                task.set_priority(GLib.PRIORITY_HIGH)
+                await task
+
+            loop.run_until_complete(run())
+        finally:
+            loop.remove_reader(s1)
+            loop.remove_reader(regular)
+            regular.close()
+            s1.close()
+            loop.close()
+
+    @unittest.skipIf(sys.platform == "win32", "add reader/writer not implemented")
+    def test_selector_source_many_fds(self):
+        loop = gi.events.GLibEventLoop(GLib.MainContext())
+        pairs = [socket.socketpair() for _ in range(64)]
+        # epoll refuses regular files, they are polled by GLib
+        regular = open(__file__, "rb")
+        try:
+            ready = []
+            for i, (s1, _) in enumerate(pairs):
+                loop.add_reader(s1, ready.append, i)
+            loop.add_reader(regular, ready.append, "regular")
+            loop.remove_reader(regular)
+            loop.add_reader(regular, ready.append, "regular")
+
+            for i in (3, 42):
+                pairs[i][1].send(b"x")
+            loop.call_later(0.1, loop.stop)
+            loop.run_forever()
+
+            self.assertEqual(set(ready), {3, 42, "regular"})
+        finally:
+            loop.remove_reader(regular)
+            regular.close()
+            for s1, s2 in pairs:
+                loop.remove_reader(s1)
+                s1.close()
+                s2.close()
+            loop.close()
+
     @unittest.skipIf(
         sys.version_info < (3, 12),
         "Older python versions do not have the loop_factory parameter",
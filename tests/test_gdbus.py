@@ -170,6 +170,27 @@ class TestGDBusClient(unittest.TestCase):
         result = self.dbus_proxy.GetNameOwner("(s)", "org.freedesktop.DBus")
         self.assertEqual(type(result), str)
 
+        # Only the exact in-signature is taken as the signature
+        with self.assertRaises(GLib.GError) as context:
+            self.dbus_proxy.GetNameOwner("(i)")
+        self.assertIn("(i)", context.exception.message)
+
+        # The signature comes from the info, not the interface name
+        other = Gio.DBusNodeInfo.new_for_xml("""
+<node>
+    <interface name='org.freedesktop.DBus'>
+        <method name='GetNameOwner'>
+            <arg name='name' direction='in' type='s'/>
+            <arg name='flags' direction='in' type='u'/>
+            <arg name='owner' direction='out' type='s'/>
+        </method>
+    </interface>
+</node>
+""")
+        self.dbus_proxy.set_interface_info(other.interfaces[0])
+        with self.assertRaises(GLib.GError):
+            self.dbus_proxy.GetNameOwner("org.freedesktop.DBus", 0)
+
         # empty return tuples get unboxed to None
         self.assertEqual(self.dbus_proxy.ReloadConfig("()"), None)
 
@@ -225,6 +246,46 @@ class TestGDBusClient(unittest.TestCase):
         except TypeError as e:
             self.assertTrue("signature" in str(e), str(e))
 
+    def test_python_calls_sync_interface_info(self):
+        # with interface info the signature can be omitted
+        info = Gio.DBusNodeInfo.new_for_xml("""
+<node>
+    <interface name='org.freedesktop.DBus'>
+        <method name='GetNameOwner'>
+            <arg name='name' direction='in' type='s'/>
+            <arg name='owner' direction='out' type='s'/>
+        </method>
+    </interface>
+</node>
+""")
+        self.dbus_proxy.set_interface_info(info.interfaces[0])
+
+        result = self.dbus_proxy.GetNameOwner("org.freedesktop.DBus")
+        self.assertEqual(type(result), str)
+        result = self.dbus_proxy.GetNameOwner("(s)", "org.freedesktop.DBus")
+        self.assertEqual(type(result), str)
+
+        # Only the exact in-signature is taken as the signature
+        with self.assertRaises(GLib.GError) as context:
+            self.dbus_proxy.GetNameOwner("(i)")
+        self.assertIn("(i)", context.exception.message)
+
+        # The signature comes from the info, not the interface name
+        other = Gio.DBusNodeInfo.new_for_xml("""
+<node>
+    <interface name='org.freedesktop.DBus'>
+        <method name='GetNameOwner'>
+            <arg name='name' direction='in' type='s'/>
+            <arg name='flags' direction='in' type='u'/>
+            <arg name='owner' direction='out' type='s'/>
+        </method>
+    </interface>
+</node>
+""")
+        self.dbus_proxy.set_interface_info(other.interfaces[0])
+        with self.assertRaises(GLib.GError):
+            self.dbus_proxy.GetNameOwner("org.freedesktop.DBus", 0)
+
     def test_python_calls_async(self):
         def call_done(obj, result, user_data):
             user_data["result"] = result
@@ -321,6 +382,83 @@ class TestDBusConnection:
             reg_id = bus.register_object(**kwargs)
             bus.unregister_object(reg_id)
 
+    @unittest.skipUnless(has_dbus, "no dbus running")
+    def test_export_object(self):
+        interface_xml = """
+            <node>
+                <interface name='org.pygobject.Export'>
+                    <method name='Add'>
+                        <arg type='i' direction='in'/>
+                        <arg type='i' direction='in'/>
+                        <arg type='i' direction='out'/>
+                    </method>
+                    <method name='Split'>
+                        <arg type='s' direction='in'/>
+                        <arg type='as' direction='out'/>
+                        <arg type='u' direction='out'/>
+                    </method>
+                    <method name='Fail' />
+                    <method name='Missing' />
+                </interface>
+            </node>"""
+        interface_info = Gio.DBusNodeInfo.new_for_xml(interface_xml).interfaces[0]
+
+        class Exported:
+            def Add(self, a, b):
+                return a + b
+
+            def Split(self, text):
+                parts = text.split()
+                return (parts, len(parts))
+
+            def Fail(self):
+                raise ValueError("failed")
+
+        bus = Gio.bus_get_sync(Gio.BusType.SESSION)
+        reg_id = bus.export_object("/pygobject/Export", interface_info, Exported())
+        main_loop = GLib.MainLoop()
+
+        def call(method, parameters):
+            def call_done(obj, result):
+                try:
+                    data["result"] = obj.call_finish(result).unpack()
+                except GLib.Error as e:
+                    data["result"] = e
+                main_loop.quit()
+
+            data = {}
+            bus.call(
+                bus.get_unique_name(),
+                "/pygobject/Export",
+                "org.pygobject.Export",
+                method,
+                parameters,
+                None,
+                Gio.DBusCallFlags.NONE,
+                5000,
+                None,
+                call_done,
+            )
+            main_loop.run()
+            return data["result"]
+
+        try:
+            assert call("Add", GLib.Variant("(ii)", (40, 2))) == (42,)
+            assert call("Split", GLib.Variant("(s)", ("a b c",))) == (
+                ["a", "b", "c"],
+                3,
+            )
+
+            error = call("Fail", None)
+            assert isinstance(error, GLib.Error)
+            assert "org.freedesktop.DBus.Python.ValueError" in error.message
+
+            error = call("Missing", None)
+            assert isinstance(error, GLib.Error)
+            assert "UnknownMethod" in error.message
+        finally:
+            bus.unregister_object(reg_id)
+
     @unittest.skipUnless(has_dbus, "no dbus running")
     def test_connection_invocation_ref_count(self):
         """Invocation object should not leak a reference."""
@@ -425,6 +563,24 @@ class AsyncDBusTests(unittest.TestCase):
 
         self.loop.run_until_complete(run())
 
+    def test_async_proxy_method_call(self):
+        async def run():
+            proxy = await Gio.DBusProxy.new_for_bus(
+                Gio.BusType.SESSION,
+                Gio.DBusProxyFlags.DO_NOT_LOAD_PROPERTIES,
+                None,
+                "org.freedesktop.DBus",
+                "/org/freedesktop/DBus",
+                "org.freedesktop.DBus",
+            )
+            result = await proxy.ListNames.call_async()
+            self.assertIn("org.freedesktop.DBus", result)
+
+            with self.assertRaises(GLib.Error):
+                await proxy.ListNames.call_async("(s)", "invalid_argument")
+
+        self.loop.run_until_complete(run())
+
     def test_async_proxy(self):
         async def run():
             proxy = await Gio.DBusProxy.new_for_bus(
@@ -1167,6 +1167,14 @@ class TestArray(unittest.TestCase):
         self.assertEqual(6, struct2.long_)
         self.assertEqual(7, struct2.int8)
 
+    def test_array_fixed_out_struct_columnar(self):
+        columns = GIMarshallingTests.array_fixed_out_struct.call_columnar()
+
+        self.assertEqual(sorted(columns), ["int8", "long_"])
+        self.assertEqual(columns["long_"].tolist(), [7, 6])
+        self.assertEqual(columns["int8"].tolist(), [6, 7])
+        self.assertEqual(columns["int8"].format, "b")
+
     def test_array_zero_terminated_return(self):
         self.assertEqual(
             ["0", "1", "2"], GIMarshallingTests.array_zero_terminated_return()
@@ -1468,6 +1476,33 @@ class TestGBytes(unittest.TestCase):
         b = GIMarshallingTests.gbytes_full_return()
         GIMarshallingTests.gbytes_none_in(b)
 
+    def test_gbytes_buffer(self):
+        b = GIMarshallingTests.gbytes_full_return()
+        view = memoryview(b)
+        self.assertTrue(view.readonly)
+        self.assertEqual(b"\x00\x31\xff\x33", view)
+        self.assertEqual(b"\x00\x31\xff\x33", bytes(b))
+
+        # The export keeps the data alive
+        b._clear_boxed()
+        self.assertEqual(b"\x00\x31\xff\x33", view.tobytes())
+        with self.assertRaises(BufferError):
+            memoryview(b)
+
+        self.assertEqual(b"", bytes(GLib.Bytes.new(b"")))
+
+    def test_gbytes_none_in_buffer(self):
+        GIMarshallingTests.gbytes_none_in(b"\x00\x31\xff\x33")
+        GIMarshallingTests.gbytes_none_in(bytearray(b"\x00\x31\xff\x33"))
+        GIMarshallingTests.gbytes_none_in(memoryview(b"--\x00\x31\xff\x33")[2:])
+        # read-only, but still changeable through the bytearray
+        GIMarshallingTests.gbytes_none_in(
+            memoryview(bytearray(b"\x00\x31\xff\x33")).toreadonly()
+        )
+
+        with self.assertRaises(TypeError):
+            GIMarshallingTests.gbytes_none_in("\x00\x31\xff\x33")
+
     def test_compare(self):
         a1 = GLib.Bytes.new(b"\x00\x01\xff")
         a2 = GLib.Bytes.new(b"\x00\x01\xff")
@@ -2470,6 +2505,28 @@ class TestStructure(unittest.TestCase):
 
         del struct
 
+    def test_simple_struct_field_descriptor(self):
+        field = GIMarshallingTests.SimpleStruct.int8
+        self.assertEqual(field.field_info.get_name(), "int8")
+
+        struct = GIMarshallingTests.SimpleStruct()
+        field.__set__(struct, -5)
+        self.assertEqual(field.__get__(struct), -5)
+        self.assertEqual(struct.int8, -5)
+
+        with self.assertRaises(OverflowError):
+            struct.int8 = 128
+        self.assertEqual(struct.int8, -5)
+
+        with self.assertRaises(TypeError):
+            struct.long_ = "foo"
+
+        with self.assertRaises(TypeError):
+            field.__get__(GIMarshallingTests.NestedStruct())
+
+        with self.assertRaises(AttributeError):
+            del struct.int8
+
     def test_nested_struct(self):
         struct = GIMarshallingTests.NestedStruct()
 
@@ -2580,6 +2637,23 @@ class TestStructure(unittest.TestCase):
         del new_struct
         del struct
 
+    def test_boxed_struct_outlives_wrapper(self):
+        structs = [GIMarshallingTests.BoxedStruct() for i in range(100)]
+        for i, struct in enumerate(structs):
+            struct.long_ = i
+
+        copies = [struct.copy() for struct in structs]
+        del structs, struct
+        gc.collect()
+
+        self.assertEqual([c.long_ for c in copies], list(range(100)))
+
+        value = GObject.Value(str, "hello")
+        copy = GObject.Value(str, value.get_value())
+        del value
+        gc.collect()
+        self.assertEqual(copy.get_value(), "hello")
+
     def test_boxed_struct_return(self):
         struct = GIMarshallingTests.boxed_struct_returnv()
 
@@ -3011,6 +3085,26 @@ class TestPythonGObject(unittest.TestCase):
         object_.method_with_default_implementation(84)
         self.assertEqual(object_.props.int, 84)
 
+    def test_object_vfunc_reentrant(self):
+        class ReentrantObject(GIMarshallingTests.Object):
+            def __init__(self):
+                GIMarshallingTests.Object.__init__(self)
+                self.vals = []
+
+            def do_method_int8_in(self, int8):
+                self.vals.append(int8)
+                if int8 > 0:
+                    self.method_int8_in(int8 - 1)
+                self.vals.append(int8)
+
+        object_ = ReentrantObject()
+        object_.method_int8_in(2)
+        self.assertEqual(object_.vals, [2, 1, 0, 0, 1, 2])
+
+        object_.vals = []
+        object_.method_int8_in(0)
+        self.assertEqual(object_.vals, [0, 0])
+
     @unittest.skipUnless(hasattr(sys, "getrefcount"), "no sys.getrefcount")
     def test_vfunc_return_ref_count(self):
         obj = self.Object(int=42)
@@ -3123,6 +3217,18 @@ class TestPythonGObject(unittest.TestCase):
         self.assertEqual(sso.subsub_method_int8_called, 1)
         self.assertEqual(sso.sub_method_int8_called, 0)
 
+    def test_vfunc_index_shared(self):
+        class PySubObject(GIMarshallingTests.Object):
+            def do_method_int8_in(self, int8):
+                pass
+
+        index = gi.types._vfunc_index(GIMarshallingTests.Object)
+        self.assertIs(gi.types._vfunc_index(PySubObject), index)
+
+        prefix, vfuncs = index
+        self.assertEqual(prefix, "do_gi_marshalling_tests_object_")
+        self.assertIn("method_int8_in", vfuncs)
+
     def test_callback_in_vfunc(self):
         class SubObject(GIMarshallingTests.Object):
             def __init__(self):
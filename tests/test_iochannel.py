@@ -96,6 +96,26 @@ second line
         with open(self.testutf8, "rb") as f:
             self.assertEqual(ch.read(max_count=15), f.read(15))
 
+    def test_file_readinto(self):
+        with open(self.testutf8, "rb") as f:
+            content = f.read()
+
+        ch = GLib.IOChannel(filename=self.testutf8)
+        buf = bytearray(10)
+        self.assertEqual(ch.readinto(buf), 10)
+        self.assertEqual(buf, content[:10])
+        view = memoryview(buf)[2:6]
+        self.assertEqual(ch.readinto(view), 4)
+        self.assertEqual(buf[2:6], content[10:14])
+
+        ch = GLib.IOChannel(filename=self.testutf8)
+        buf = bytearray(100)
+        self.assertEqual(ch.readinto(buf), len(content))
+        self.assertEqual(buf[: len(content)], content)
+        self.assertEqual(ch.readinto(buf), 0)
+
+        self.assertRaises(TypeError, ch.readinto, b"readonly")
+
     def test_file_read_chars(self):
         ch = GLib.IOChannel(filename=self.testutf8)
         with open(self.testutf8, "rb") as f:
@@ -419,6 +419,20 @@ def test_object_constructed_after_init_by_new():
     assert obj.order == ["__init__1", "__init__2", "do_constructed"]
 
 
+def test_object_constructed_added_later():
+    class Later(GObject.Object):
+        pass
+
+    assert not hasattr(Later(), "constructed_called")
+
+    def do_constructed(self):
+        self.constructed_called = True
+
+    Later.do_constructed = do_constructed
+    assert Later().constructed_called
+    assert GObject.new(Later).constructed_called
+
+
 def test_object_with_post_init_and_interface():
     class PostInit(Regress.TestObj, Regress.TestInterface):
         number = GObject.Property(type=int)
@@ -52,6 +52,29 @@ def test_list_store_sort():
     assert store[:] == sorted_items
 
 
+def test_list_store_sort_by_key():
+    store = Gio.ListStore()
+    items = [NamedItem(name=n) for n in "cabx"]
+    calls = []
+
+    def key(item):
+        assert isinstance(item, NamedItem)
+        calls.append(item)
+        return item.props.name
+
+    changes = []
+    store[:] = items
+    store.connect("items-changed", lambda *args: changes.append(args[1:]))
+
+    store.sort_by_key(key)
+    assert store[:] == sorted(items, key=lambda i: i.props.name)
+    assert sorted(calls, key=id) == sorted(items, key=id)
+    assert changes == [(0, 4, 4)]
+
+    store.sort_by_key(key, reverse=True)
+    assert store[:] == sorted(items, key=lambda i: i.props.name, reverse=True)
+
+
 def test_list_store_insert_sorted():
     store = Gio.ListStore()
     items = [NamedItem(name=n) for n in "cabx"]
@@ -383,6 +406,21 @@ def test_file_fspath():
         assert file_like.read() == content
 
 
+def test_input_stream_readinto():
+    stream = Gio.MemoryInputStream.new_from_bytes(GLib.Bytes(b"hello world"))
+    buf = bytearray(5)
+    assert stream.readinto(buf) == 5
+    assert buf == b"hello"
+    assert stream.readinto(memoryview(buf)[1:], Gio.Cancellable()) == 4
+    assert buf == b"h wor"
+    assert stream.readinto(buf) == 2
+    assert buf[:2] == b"ld"
+    assert stream.readinto(buf) == 0
+
+    with pytest.raises(TypeError):
+        stream.readinto(bytes(5))
+
+
 def test_file_fspath_with_no_path():
     file = Gio.File.new_for_path("")
     path = file.peek_path()
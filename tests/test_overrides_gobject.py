@@ -413,3 +413,23 @@ def test_value_object():
             setter(object())
 
         v.reset()
+
+
+def test_value_boxed():
+    # converters of boxed types are resolved once per type, make sure
+    # different boxed types don't share them
+    for _ in range(2):
+        v = GObject.Value(GObject.TYPE_STRV)
+        assert v.get_value() is None
+        v.set_value(["foo", "bar"])
+        assert v.get_value() == ["foo", "bar"]
+
+        v = GObject.Value(GObject.TYPE_VALUE)
+        v.set_value(42)
+        assert v.get_value() == 42
+
+        v = GObject.Value(GLib.String.__gtype__)
+        v.set_value("foo")
+        assert v.get_value() == "foo"
+        with pytest.raises(TypeError):
+            v.set_value(object())
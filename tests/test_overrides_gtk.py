@@ -2075,6 +2075,27 @@ class TestTreeModel(unittest.TestCase):
         list_store.set(tree_iter, (0, 1), (20, True))
         self.assertEqual(signals, ["row-inserted", "row-changed"])
 
+    def test_list_store_extend(self):
+        list_store = Gtk.ListStore(int, str, object)
+        signals = []
+        list_store.connect("row-inserted", lambda *args: signals.append(args[1]))
+
+        obj = object()
+        list_store.append((1, "first", None))
+        list_store.extend((i, str(i), obj) for i in range(2, 5))
+        list_store.extend([])
+
+        self.assertEqual(
+            [list(row) for row in list_store],
+            [[1, "first", None], [2, "2", obj], [3, "3", obj], [4, "4", obj]],
+        )
+        self.assertEqual([str(path) for path in signals], ["0", "1", "2", "3"])
+
+        with self.assertRaises(ValueError):
+            list_store.extend([(1, "too short")])
+        with self.assertRaises(TypeError):
+            list_store.extend(["abc"])
+
     def test_list_store_insert_before(self):
         store = Gtk.ListStore(object)
         signals = []
@@ -36,6 +36,11 @@ class TestResultTuple(unittest.TestCase):
             new = ResultTuple._new_type(names)
             self.assertTrue(issubclass(new, ResultTuple))
 
+    def test_create_shared(self):
+        new = ResultTuple._new_type([None, "foo", None, "bar"])
+        self.assertIs(ResultTuple._new_type([None, "foo", None, "bar"]), new)
+        self.assertIsNot(ResultTuple._new_type([None, "foo", "bar"]), new)
+
     def test_repr_dir(self):
         new = ResultTuple._new_type([None, "foo", None, "bar"])
         inst = new([1, 2, 3, "a"])
@@ -57,6 +62,29 @@ class TestResultTuple(unittest.TestCase):
         self.assertEqual(inst.foo, inst[1])
         self.assertRaises(AttributeError, getattr, inst, "nope")
 
+    def test_getattr_readonly(self):
+        new = ResultTuple._new_type(["count", "foo"])
+        inst = new([1, 2])
+
+        # names shadow the tuple methods
+        self.assertEqual(inst.count, 1)
+        self.assertRaises(AttributeError, setattr, inst, "foo", 3)
+
+    def test_create_free_many(self):
+        # instances share the cached type, freeing them must not drop
+        # references to it
+        new = ResultTuple._new_type([None, "foo"])
+        for i in range(5000):
+            inst = new([i, "a"])
+            self.assertEqual(inst.foo, "a")
+            del inst
+        self.assertIs(ResultTuple._new_type([None, "foo"]), new)
+
+        for i in range(5000):
+            res = GIMarshallingTests.array_out_etc(-5, 9)
+            self.assertEqual(res.sum, 4)
+            del res
+
     def test_pickle(self):
         new = ResultTuple._new_type([None, "foo", None, "bar"])
         inst = new([1, 2, 3, "a"])
@@ -1,5 +1,7 @@
 import sys
 import gc
+import threading
+import time
 import unittest
 import warnings
 
@@ -103,6 +105,97 @@ class TestSource(unittest.TestCase):
 
         assert dispatched[0]
 
+    def test_source_no_check(self):
+        loop = GLib.MainLoop()
+        calls = []
+
+        class NoCheck(GLib.Source):
+            check = None
+
+            def prepare(self):
+                calls.append("prepare")
+                return (len(calls) > 2, 0)
+
+            def dispatch(self, callback, args):
+                calls.append("dispatch")
+                loop.quit()
+                return False
+
+        source = NoCheck()
+        source.attach()
+        loop.run()
+
+        self.assertEqual(calls, ["prepare", "prepare", "prepare", "dispatch"])
+
+    def test_source_methods_changed(self):
+        context = GLib.MainContext()
+        calls = []
+
+        class S(GLib.Source):
+            def prepare(self):
+                calls.append("class")
+                return (False, 0)
+
+            def check(self):
+                return False
+
+        source = S()
+        source.attach(context)
+        context.iteration(False)
+
+        S.prepare = lambda self: calls.append("changed") or (False, 0)
+        context.iteration(False)
+        source.destroy()
+
+        self.assertEqual(calls, ["class", "changed"])
+
+    def test_source_methods_instance(self):
+        context = GLib.MainContext()
+        calls = []
+
+        class S(GLib.Source):
+            def prepare(self):
+                calls.append("class")
+                return (False, 0)
+
+            def check(self):
+                return False
+
+        source = S()
+        source.attach(context)
+        context.iteration(False)
+
+        # Set on the instance after the source got prepared once
+        source.prepare = lambda: calls.append("instance") or (False, 0)
+        context.iteration(False)
+        del source.prepare
+        context.iteration(False)
+        source.destroy()
+
+        self.assertEqual(calls, ["class", "instance", "class"])
+
+    def test_source_methods_static(self):
+        context = GLib.MainContext()
+        calls = []
+
+        class S(GLib.Source):
+            @staticmethod
+            def prepare():
+                calls.append("static")
+                return (False, 0)
+
+            @classmethod
+            def check(cls):
+                calls.append(cls)
+                return False
+
+        source = S()
+        source.attach(context)
+        context.iteration(False)
+        source.destroy()
+
+        self.assertEqual(calls, ["static", S])
+
     def test_is_destroyed_simple(self):
         s = GLib.Source()
 
@@ -309,6 +402,58 @@ class TestSource(unittest.TestCase):
         self.assertEqual(source.arg, 1)
         self.assertEqual(source.kwarg, 2)
 
+    def test_idle_batch(self):
+        context = GLib.MainContext()
+        batch = GLib.IdleBatch(GLib.PRIORITY_LOW)
+        self.assertEqual(batch.priority, GLib.PRIORITY_LOW)
+        self.assertEqual(batch.get_name(), "GLib.IdleBatch")
+        batch.attach(context)
+
+        result = []
+
+        def push(n):
+            for i in range(100):
+                batch.add(result.append, (n, i))
+
+        threads = [threading.Thread(target=push, args=(n,)) for n in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertTrue(context.iteration(False))
+        self.assertEqual(len(result), 400)
+        for n in range(4):
+            self.assertEqual([i for m, i in result if m == n], list(range(100)))
+        self.assertFalse(context.iteration(False))
+
+        with self.assertRaises(TypeError):
+            batch.add(None)
+
+        batch.destroy()
+        with self.assertRaises(RuntimeError):
+            batch.add(result.append, 0)
+
+    def test_idle_batch_budget(self):
+        context = GLib.MainContext()
+        batch = GLib.IdleBatch(budget=1)
+        batch.attach(context)
+
+        result = []
+
+        def work(i):
+            time.sleep(0.002)
+            result.append(i)
+
+        for i in range(3):
+            batch.add(work, i)
+
+        for i in range(3):
+            self.assertTrue(context.iteration(False))
+            self.assertEqual(result, list(range(i + 1)))
+        self.assertFalse(context.iteration(False))
+        batch.destroy()
+
 
 @unittest.skipIf(sys.platform == "darwin", "hangs")
 class TestUserData(unittest.TestCase):
@@ -0,0 +1,33 @@
+"""Measure creation and destruction of small boxed wrappers.
+
+Run against a build with e.g.:
+
+    python3 tools/bench-boxed.py
+"""
+
+import timeit
+
+import gi
+from gi.repository import GObject
+
+try:
+    gi.require_version("Gdk", "4.0")
+    from gi.repository import Gdk
+except (ImportError, ValueError):
+    Gdk = None
+
+
+def bench(name, func, number=1_000_000):
+    best = min(timeit.repeat(func, number=number, repeat=5))
+    print(f"{name:<20} {best / number * 1e9:8.1f} ns/op")
+
+
+def main():
+    bench("GObject.Value()", GObject.Value)
+    if Gdk is not None:
+        bench("Gdk.RGBA()", Gdk.RGBA)
+        bench("Gdk.Rectangle()", Gdk.Rectangle)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,45 @@
+"""Measure defining Python subclasses of GObject classes.
+
+Run against a build with e.g.:
+
+    python3 tools/bench-class-new.py
+"""
+
+import itertools
+import timeit
+
+from gi.repository import GIMarshallingTests, GObject
+
+counter = itertools.count()
+
+
+def define_object():
+    class Item(GObject.Object):
+        __gtype_name__ = f"BenchItem{next(counter)}"
+
+        value = GObject.Property(type=int)
+
+
+def define_vfunc_override():
+    class Sub(GIMarshallingTests.Object):
+        __gtype_name__ = f"BenchSub{next(counter)}"
+
+        def do_method_int8_in(self, int8):
+            pass
+
+        def do_method_with_default_implementation(self, int8):
+            pass
+
+
+def bench(name, func, number=2_000):
+    best = min(timeit.repeat(func, number=number, repeat=5))
+    print(f"{name:<30} {best / number * 1e6:8.1f} us/class")
+
+
+def main():
+    bench("GObject.Object subclass", define_object)
+    bench("vfunc overrides", define_vfunc_override)
+
+
+if __name__ == "__main__":
+    main()
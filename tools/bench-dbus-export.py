@@ -0,0 +1,110 @@
+"""Measure D-Bus method calls to objects exported from Python.
+
+Starts a private dbus-daemon and compares DBusConnection.register_object()
+with a Python closure against DBusConnection.export_object(). Run against a
+build with e.g.:
+
+    python3 tools/bench-dbus-export.py
+"""
+
+import subprocess
+import threading
+import time
+
+from gi.repository import GLib, Gio
+
+INTERFACE_XML = """
+<node>
+    <interface name='org.pygobject.Bench'>
+        <method name='Add'>
+            <arg type='i' direction='in'/>
+            <arg type='i' direction='in'/>
+            <arg type='i' direction='out'/>
+        </method>
+    </interface>
+</node>"""
+
+
+class Exported:
+    def Add(self, a, b):
+        return a + b
+
+
+def on_method_call(
+    connection, sender, object_path, interface_name, method_name, params, inv
+):
+    a, b = params.unpack()
+    inv.return_value(GLib.Variant("(i)", (a + b,)))
+
+
+def serve(address, ready, stop):
+    context = GLib.MainContext()
+    context.push_thread_default()
+    connection = Gio.DBusConnection.new_for_address_sync(
+        address,
+        Gio.DBusConnectionFlags.AUTHENTICATION_CLIENT
+        | Gio.DBusConnectionFlags.MESSAGE_BUS_CONNECTION,
+        None,
+        None,
+    )
+    info = Gio.DBusNodeInfo.new_for_xml(INTERFACE_XML).interfaces[0]
+    connection.register_object("/closure", info, on_method_call)
+    connection.export_object("/export", info, Exported())
+
+    ready.append(connection.get_unique_name())
+    while not stop:
+        context.iteration(True)
+
+
+def bench(name, connection, server, object_path, number=20_000):
+    args = GLib.Variant("(ii)", (40, 2))
+    start = time.perf_counter()
+    for _ in range(number):
+        connection.call_sync(
+            server,
+            object_path,
+            "org.pygobject.Bench",
+            "Add",
+            args,
+            None,
+            Gio.DBusCallFlags.NONE,
+            -1,
+            None,
+        )
+    elapsed = time.perf_counter() - start
+    print(f"{name:<20} {elapsed / number * 1e6:8.1f} us/call")
+
+
+def main():
+    daemon = subprocess.Popen(
+        ["dbus-daemon", "--session", "--nofork", "--print-address"],
+        stdout=subprocess.PIPE,
+        text=True,
+    )
+    try:
+        address = daemon.stdout.readline().strip()
+        ready, stop = [], []
+        thread = threading.Thread(
+            target=serve, args=(address, ready, stop), daemon=True
+        )
+        thread.start()
+        while not ready:
+            time.sleep(0.01)
+
+        connection = Gio.DBusConnection.new_for_address_sync(
+            address,
+            Gio.DBusConnectionFlags.AUTHENTICATION_CLIENT
+            | Gio.DBusConnectionFlags.MESSAGE_BUS_CONNECTION,
+            None,
+            None,
+        )
+        bench("register_object()", connection, ready[0], "/closure")
+        bench("export_object()", connection, ready[0], "/export")
+        stop.append(True)
+    finally:
+        daemon.terminate()
+        daemon.wait()
+
+
+if __name__ == "__main__":
+    main()
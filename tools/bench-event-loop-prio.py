@@ -0,0 +1,63 @@
+"""Measure running prioritized tasks on the GLibEventLoop.
+
+Every dispatch of prioritized tasks pauses and resumes the selector source,
+so this is run with a varying number of registered readers. Run against a
+build with e.g.:
+
+    python3 tools/bench-event-loop-prio.py
+"""
+
+import asyncio
+import socket
+import time
+
+import gi.events
+from gi.repository import GLib
+
+PRIORITIES = [GLib.PRIORITY_HIGH, 50, GLib.PRIORITY_DEFAULT_IDLE, 150]
+
+
+async def step(priority):
+    await asyncio.sleep(0)
+
+
+async def run(number):
+    tasks = []
+    for i in range(number):
+        priority = PRIORITIES[i % len(PRIORITIES)]
+        task = asyncio.create_task(step(priority))
+        task.set_priority(priority)
+        tasks.append(task)
+    await asyncio.wait(tasks)
+
+
+def bench(name, n_sockets, number=20_000):
+    loop = gi.events.GLibEventLoop(GLib.MainContext())
+    pairs = [socket.socketpair() for _ in range(n_sockets)]
+    try:
+        for s1, _ in pairs:
+            loop.add_reader(s1, lambda: None)
+
+        best = None
+        for _ in range(5):
+            start = time.perf_counter()
+            loop.run_until_complete(run(number))
+            elapsed = time.perf_counter() - start
+            best = elapsed if best is None else min(best, elapsed)
+        print(f"{name:<30} {best / number * 1e6:8.2f} us/task")
+    finally:
+        for s1, s2 in pairs:
+            loop.remove_reader(s1)
+            s1.close()
+            s2.close()
+        loop.close()
+
+
+def main():
+    bench("no readers", 0)
+    bench("64 readers", 64)
+    bench("1024 readers", 1024)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,43 @@
+"""Measure instantiating Python subclasses of GObject.Object.
+
+Run against a build with e.g.:
+
+    python3 tools/bench-object-new.py
+"""
+
+import timeit
+
+from gi.repository import GObject
+
+
+class Item(GObject.Object):
+    name = GObject.Property(type=str)
+
+
+class ItemWithInit(GObject.Object):
+    def __init__(self, name):
+        super().__init__(name=name)
+
+    name = GObject.Property(type=str)
+
+
+class ItemWithConstructed(GObject.Object):
+    def do_constructed(self):
+        pass
+
+
+def bench(name, func, number=1_000_000):
+    best = min(timeit.repeat(func, number=number, repeat=5))
+    print(f"{name:<30} {best / number * 1e9:8.1f} ns/op")
+
+
+def main():
+    bench("Item()", Item)
+    bench("Item(name=...)", lambda: Item(name="item"))
+    bench("ItemWithInit(...)", lambda: ItemWithInit("item"))
+    bench("ItemWithConstructed()", ItemWithConstructed)
+    bench("GObject.new(Item)", lambda: GObject.new(Item))
+
+
+if __name__ == "__main__":
+    main()